@@ -0,0 +1,52 @@
+// Stable C ABI for generator plugins.
+//
+// A plugin is a shared library (.so / .dll) placed in the plugins directory that
+// exports manim_generator_plugin(). The host copies the library before loading
+// it, so a plugin can be rebuilt in place while the application runs; the new
+// build is picked up on the next frame without losing camera state.
+//
+// Vertices are interleaved x, y, z, r, g, b floats, the same layout the built-in
+// CPU generators write.
+#ifndef GENERATOR_PLUGIN_H
+#define GENERATOR_PLUGIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MANIM_PLUGIN_ABI_VERSION 1
+
+#define MANIM_PRIMITIVE_POINTS 0
+#define MANIM_PRIMITIVE_LINE_STRIP 1
+
+#ifdef _WIN32
+#define MANIM_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define MANIM_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+typedef struct ManimGeneratorPlugin {
+  uint32_t abiVersion;  // MANIM_PLUGIN_ABI_VERSION
+  const char *name;
+  uint32_t primitive;      // MANIM_PRIMITIVE_*
+  uint32_t timeDependent;  // 0 if the output only depends on the quality level
+
+  // Upper bound on the vertices generate() writes for a quality multiplier (1, 2, 4 or 8)
+  size_t (*maxVertices)(int qualityMult);
+
+  // Writes at most `capacity` vertices into `out` and returns the number written
+  size_t (*generate)(float *out, size_t capacity, float t, int qualityMult);
+} ManimGeneratorPlugin;
+
+// Exported by every plugin; the returned descriptor must stay valid while the library is loaded
+typedef const ManimGeneratorPlugin *(*ManimGeneratorPluginEntry)(void);
+#define MANIM_PLUGIN_ENTRY_SYMBOL "manim_generator_plugin"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // GENERATOR_PLUGIN_H
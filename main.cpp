@@ -4,52 +4,384 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cmath>
+#include <cstddef>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
-// Vertex shader source
-const char *vertexShaderSource = R"(
-#version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aColor;
+#include "generator_plugin.h"
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
 
-out vec3 FragColor;
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 
-void main()
-{
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-    FragColor = aColor;
+using namespace std;
+
+// Heap telemetry. Building with -DALLOC_TELEMETRY (make TELEMETRY=1) replaces the
+// global operator new/delete with counting versions; every allocation carries a
+// small header holding its size so live bytes can be tracked on release.
+namespace AllocTelemetry {
+#ifdef ALLOC_TELEMETRY
+const bool enabled = true;
+#else
+const bool enabled = false;
+#endif
+
+std::atomic<size_t> allocations(0);
+std::atomic<size_t> allocatedBytes(0);
+std::atomic<size_t> liveBytes(0);
+std::atomic<size_t> peakLiveBytes(0);  // Reset at the start of every frame
+
+inline void recordAllocation(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  size_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+  size_t peak = peakLiveBytes.load(std::memory_order_relaxed);
+  while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+inline void recordRelease(size_t size) { liveBytes.fetch_sub(size, std::memory_order_relaxed); }
+}  // namespace AllocTelemetry
+
+#ifdef ALLOC_TELEMETRY
+static const size_t kAllocHeader = alignof(std::max_align_t);
+
+void *operator new(size_t size) {
+  unsigned char *base = static_cast<unsigned char *>(std::malloc(size + kAllocHeader));
+  if (!base) throw std::bad_alloc();
+  *reinterpret_cast<size_t *>(base) = size;
+  AllocTelemetry::recordAllocation(size);
+  return base + kAllocHeader;
 }
-)";
 
-// Fragment shader source
-const char *fragmentShaderSource = R"(
-#version 330 core
-in vec3 FragColor;
-out vec4 color;
+void *operator new[](size_t size) { return operator new(size); }
 
-void main()
-{
-    color = vec4(FragColor, 1.0);
+void operator delete(void *ptr) noexcept {
+  if (!ptr) return;
+  unsigned char *base = static_cast<unsigned char *>(ptr) - kAllocHeader;
+  AllocTelemetry::recordRelease(*reinterpret_cast<size_t *>(base));
+  std::free(base);
 }
-)";
 
-using namespace std;
+void operator delete[](void *ptr) noexcept { operator delete(ptr); }
+void operator delete(void *ptr, size_t) noexcept { operator delete(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { operator delete(ptr); }
+#endif
+
+// Heap activity attributed to one animation mode
+struct ModeMemoryStats {
+  size_t frames = 0;
+  size_t allocations = 0;
+  size_t allocatedBytes = 0;
+  size_t peakLiveBytes = 0;
+  size_t retainedBytes = 0;  // Live heap bytes after the last frame spent in this mode
+};
+
+// Tracks GPU storage allocated through glBufferData, per buffer object
+class GpuBufferTracker {
+ public:
+  void allocate(GLenum target, GLuint buffer, size_t bytes, const void *data, GLenum usage) {
+    glBufferData(target, bytes, data, usage);
+    size_t &current = sizes[buffer];
+    totalBytes = totalBytes - current + bytes;
+    current = bytes;
+  }
+
+  void release(GLuint buffer) {
+    auto it = sizes.find(buffer);
+    if (it == sizes.end()) return;
+    totalBytes -= it->second;
+    sizes.erase(it);
+  }
+
+  size_t size(GLuint buffer) const {
+    auto it = sizes.find(buffer);
+    return it == sizes.end() ? 0 : it->second;
+  }
+
+  size_t total() const { return totalBytes; }
+
+ private:
+  std::unordered_map<GLuint, size_t> sizes;
+  size_t totalBytes = 0;
+};
+
+// Formats a byte count with a binary unit suffix
+inline std::string formatBytes(double bytes) {
+  const char *units[] = {"B", "KB", "MB", "GB"};
+  int unit = 0;
+  while (bytes >= 1024.0 && unit < 3) {
+    bytes /= 1024.0;
+    ++unit;
+  }
+  char text[32];
+  snprintf(text, sizeof(text), unit == 0 ? "%.0f %s" : "%.1f %s", bytes, units[unit]);
+  return text;
+}
+
+// Time-to-first-frame breakdown. Each mark() closes the phase that started at the
+// previous mark; the report is printed once the first frame has been presented.
+struct StartupProfile {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::time_point last = start;
+  std::vector<std::pair<const char *, double>> phases;
+  double firstGenerateMs = 0.0;
+  bool reported = false;
+
+  void mark(const char *phase) {
+    auto now = std::chrono::steady_clock::now();
+    phases.emplace_back(phase, std::chrono::duration<double, std::milli>(now - last).count());
+    last = now;
+  }
+
+  void report() {
+    std::cout << "Startup:";
+    for (const auto &phase : phases) {
+      std::cout << " " << phase.first << " " << std::fixed << std::setprecision(1) << phase.second << " ms |";
+    }
+    std::cout << " first generate " << firstGenerateMs << " ms | first frame presented at "
+              << std::chrono::duration<double, std::milli>(last - start).count() << " ms" << std::defaultfloat << "\n";
+    reported = true;
+  }
+};
+
+// Best rational approximation p/q of x with q <= maxDenominator, from the
+// continued fraction convergents and the last admissible semiconvergent
+inline void rationalApproximation(double x, int maxDenominator, int &p, int &q) {
+  long long p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+  double v = x;
+  for (;;) {
+    long long a = (long long)std::floor(v);
+    if (q0 + a * q1 > maxDenominator) break;
+    long long p2 = p0 + a * p1, q2 = q0 + a * q1;
+    p0 = p1, q0 = q1, p1 = p2, q1 = q2;
+    double fraction = v - a;
+    if (fraction < 1e-12) break;
+    v = 1.0 / fraction;
+  }
+
+  long long k = (maxDenominator - q0) / q1;
+  long long ps = p0 + k * p1, qs = q0 + k * q1;
+  bool semiconvergent = k > 0 && std::fabs(x - (double)ps / qs) < std::fabs(x - (double)p1 / q1);
+  p = (int)(semiconvergent ? ps : p1);
+  q = (int)(semiconvergent ? qs : q1);
+}
+
+// Simplest fraction p/q (smallest q <= maxDenominator) within `tolerance` of x,
+// falling back to the best approximation when no such fraction exists
+inline void simplestRationalNear(double x, double tolerance, int maxDenominator, int &p, int &q) {
+  for (q = 1; q <= maxDenominator; ++q) {
+    p = (int)std::ceil((x - tolerance) * q);
+    if (p <= (x + tolerance) * q) return;
+  }
+  rationalApproximation(x, maxDenominator, p, q);
+}
+
+// Per-vertex trig tables for one closed hypotrochoid period. For R/r = p/q the
+// curve closes after theta = 2 pi q and the inner frequency is k = (p - q) / q.
+// Positions are then (R - r, d)-weighted sums of these tables, so the tables only
+// change when the ratio or the vertex count does.
+struct HypotrochoidPeriod {
+  int p = 0, q = 0;
+  size_t points = 0;
+  std::vector<float> cosTheta, sinTheta, cosKTheta, sinKTheta;
+};
+
+// The two keyframes a stable-topology mode is interpolated between: slot 0 is
+// uploaded to VBO and slot 1 to the keyframe buffer. Keyframe n is the mode
+// generated at time n / rate, and the newer slot is always one keyframe ahead of
+// the other, so frames in between blend the pair.
+struct KeyframePair {
+  long long index[2] = {-1, -1};  // -1 until generated
+  size_t count[2] = {0, 0};
+  int tessellationLevel[2] = {0, 0};
+  int newest = 0;
+};
+
+// Point grids of heightfield modes are split into square chunks stored one after
+// another. Vertex (i, j) belongs to level k when i and j are both multiples of 2^k;
+// within a chunk vertices are sorted coarsest level first, so levels >= k, a grid
+// at 2^k times the spacing, are a prefix of the chunk.
+const int heightfieldChunkCells = 32;
+const int heightfieldLevels = 4;
+
+struct HeightfieldChunk {
+  float minX, maxX, minZ, maxZ;
+  GLint first;
+  GLsizei levelCounts[heightfieldLevels];  // Vertices in levels >= k
+};
+
+// Static x/z grid for a GPU-displaced heightfield mode
+struct HeightfieldMesh {
+  GLuint vao = 0, vbo = 0;
+  int builtQuality = -1;  // Quality level the grid was built for
+  GLsizei vertexCount = 0;
+  float heightBound = 0.0f;  // Largest |y| the mode's vertex shader produces, for culling
+
+  // Chunks of point grids; line meshes have none and are drawn whole. The draw
+  // lists are sized with the chunks and refilled every frame.
+  std::vector<HeightfieldChunk> chunks;
+  std::vector<GLint> drawFirsts;
+  std::vector<GLsizei> drawCounts;
+  GLsizei drawnChunks = 0, drawnVertices = 0;
+};
+
+// Row-major grid of CPU-computed heights streamed through a texture buffer
+struct HeightStream {
+  GLuint vao = 0;      // Attribute-less; vertices are pulled by gl_VertexID
+  GLuint buffer = 0;   // One float per cell
+  GLuint texture = 0;  // R32F texture buffer view of the cells
+  GLuint colormap = 0;
+  int resolution = 0;
+  size_t cells = 0;  // Cells uploaded
+  float origin[2] = {0.0f, 0.0f};
+  float spacing[2] = {1.0f, 1.0f};
+  float heightScale = 1.0f, heightOffset = 0.0f;
+};
+
+// Double-double arithmetic (about 106 significand bits) for the deep-zoom
+// reference orbit, built from error-free sum and fma product transforms
+struct DoubleDouble {
+  double hi, lo;
+};
+
+inline DoubleDouble ddAdd(DoubleDouble a, DoubleDouble b) {
+  double s = a.hi + b.hi;
+  double v = s - a.hi;
+  double e = (a.hi - (s - v)) + (b.hi - v) + a.lo + b.lo;
+  double hi = s + e;
+  return {hi, e - (hi - s)};
+}
+
+inline DoubleDouble ddMul(DoubleDouble a, DoubleDouble b) {
+  double p = a.hi * b.hi;
+  double e = std::fma(a.hi, b.hi, -p) + a.hi * b.lo + a.lo * b.hi;
+  double hi = p + e;
+  return {hi, e - (hi - p)};
+}
+
+// Mandelbrot orbit of one high-precision reference point. Pixels iterate only
+// their double-precision offset from it (perturbation), so the orbit is the only
+// work done at full precision. It is extended on demand as the iteration limit
+// grows and kept across frames while the center is unchanged.
+struct ReferenceOrbit {
+  DoubleDouble cr = {0.0, 0.0}, ci = {0.0, 0.0};
+  DoubleDouble zr = {0.0, 0.0}, zi = {0.0, 0.0};  // Next value to append
+  std::vector<double> re, im;                     // Z_n rounded to double, from Z_0 = 0
+  bool escaped = false;
+
+  void reset(DoubleDouble centerRe, DoubleDouble centerIm) {
+    cr = centerRe;
+    ci = centerIm;
+    zr = zi = {0.0, 0.0};
+    re.clear();
+    im.clear();
+    escaped = false;
+  }
+
+  // Makes Z_0 .. Z_iterations available unless the reference escapes first
+  void extend(int iterations) {
+    while (!escaped && (int)re.size() <= iterations) {
+      re.push_back(zr.hi);
+      im.push_back(zi.hi);
+      if (zr.hi * zr.hi + zi.hi * zi.hi > 4.0) {
+        escaped = true;
+        break;
+      }
+      DoubleDouble r2 = ddMul(zr, zr), i2 = ddMul(zi, zi), ri = ddMul(zr, zi);
+      zr = ddAdd(ddAdd(r2, {-i2.hi, -i2.lo}), cr);
+      zi = ddAdd({2.0 * ri.hi, 2.0 * ri.lo}, ci);
+    }
+  }
+};
+
+// Vector fields the particle engine can advect; the index is uField in the
+// update shader
+struct AttractorField {
+  const char *name;
+  float dt;
+  int substeps;
+  float bound;       // Particles further than this from seedCenter are respawned
+  float seedCenter[3];
+  float seedExtent;  // Half-size of the respawn box
+  float scale[3], offset[3];  // Attractor space to scene space
+  float speedScale;
+};
+
+const AttractorField attractorFields[] = {
+    {"Lorenz", 0.005f, 2, 200.0f, {0.0f, 0.0f, 25.0f}, 20.0f, {0.1f, 0.1f, 0.1f}, {0.0f, -0.5f, -0.5f}, 0.05f},
+    {"Rossler", 0.02f, 2, 200.0f, {0.0f, 0.0f, 2.0f}, 10.0f, {0.08f, 0.08f, 0.08f}, {0.0f, 0.0f, -0.8f}, 0.05f},
+    {"Thomas", 0.05f, 2, 50.0f, {0.0f, 0.0f, 0.0f}, 4.0f, {0.25f, 0.25f, 0.25f}, {0.0f, 0.0f, 0.0f}, 0.5f},
+    {"Aizawa", 0.01f, 2, 10.0f, {0.0f, 0.0f, 0.0f}, 1.0f, {0.8f, 0.8f, 0.8f}, {0.0f, 0.0f, -0.5f}, 0.4f},
+};
+const int attractorFieldCount = sizeof(attractorFields) / sizeof(attractorFields[0]);
+
+// Ping-pong particle state buffers (vec4 per particle) for transform feedback
+struct ParticleSystem {
+  GLuint vao[2] = {0, 0}, vbo[2] = {0, 0};
+  int current = 0;  // Buffer holding the latest states
+  GLsizei count = 0;
+  int field = -1;   // Field the states were seeded for
+  unsigned seed = 0;
+};
+
+// Fragment-shader fractal, drawn over the whole screen or rendered into a
+// heightmap that displaces a point grid
+struct GpuFractal {
+  GLuint vao = 0;          // Attribute-less; both passes pull vertices by gl_VertexID
+  GLuint framebuffer = 0;
+  GLuint heightMap = 0;    // R32F, one texel per grid cell
+  GLuint colormap = 0;
+  int resolution = 0;      // Heightmap size, rebuilt when the quality level changes it
+  bool complete = false;   // False if the driver rejected the R32F render target
+};
+
+// Renderer path that draws a mode
+enum class DrawPath {
+  CpuVertices,     // Interleaved position/color vertices generated on the CPU
+  CpuPlanar,       // Interleaved x, y, r, g, b vertices in the z = 0 plane, drawn by the 2D shader
+  CpuScalar,       // Interleaved x, y, z, s vertices; s is mapped through the selected colormap
+  GpuHeightfield,  // Static x/z grid displaced by a dedicated vertex shader
+  HeightStream,    // CPU-computed heights streamed one float per cell
+  GpuParticles,    // Transform-feedback particle engine, no CPU generation
+  GpuFractal,      // Escape time evaluated in a fragment shader, no CPU generation
+};
+
+// Per-frame CPU cost of a mode
+enum class CostClass { Free, Light, Heavy };
+const char *costClassNames[] = {"free", "light", "heavy"};
 
 // Color palette
 struct Color {
@@ -74,1056 +406,3606 @@ const Color DARK_GREEN(0.05f, 0.2f, 0.05f);
 const Color DARK_PURPLE(0.15f, 0.05f, 0.2f);
 }  // namespace Colors
 
-class MathAnimation {
- private:
-  GLFWwindow *window;
-  GLuint shaderProgram;
-  GLuint VAO, VBO;
+// Colormaps for scalar-colored modes, as nine evenly spaced RGB stops sampled
+// from the matplotlib maps of the same name
+struct Colormap {
+  const char *name;
+  float stops[9 * 3];
+};
 
-  vector<float> vertices;
-  // Animation parameters
-  float time;
-  int animationMode;
-  int backgroundMode;
+const Colormap colormaps[] = {
+    {"viridis",
+     {0.267f, 0.005f, 0.329f, 0.283f, 0.141f, 0.458f, 0.254f, 0.265f, 0.530f, 0.207f, 0.372f, 0.553f, 0.164f, 0.471f, 0.558f, 0.128f, 0.567f,
+      0.551f, 0.135f, 0.659f, 0.518f, 0.478f, 0.821f, 0.318f, 0.993f, 0.906f, 0.144f}},
+    {"magma",
+     {0.001f, 0.000f, 0.014f, 0.079f, 0.054f, 0.212f, 0.232f, 0.060f, 0.438f, 0.390f, 0.100f, 0.502f, 0.550f, 0.161f, 0.506f, 0.716f, 0.215f,
+      0.475f, 0.869f, 0.288f, 0.409f, 0.968f, 0.440f, 0.360f, 0.987f, 0.991f, 0.750f}},
+    {"inferno",
+     {0.001f, 0.000f, 0.014f, 0.087f, 0.045f, 0.225f, 0.258f, 0.039f, 0.406f, 0.416f, 0.090f, 0.433f, 0.578f, 0.148f, 0.404f, 0.736f, 0.216f,
+      0.330f, 0.865f, 0.317f, 0.226f, 0.955f, 0.469f, 0.100f, 0.988f, 0.998f, 0.645f}},
+    {"plasma",
+     {0.050f, 0.030f, 0.528f, 0.255f, 0.014f, 0.615f, 0.418f, 0.001f, 0.658f, 0.563f, 0.052f, 0.642f, 0.693f, 0.165f, 0.565f, 0.798f, 0.280f,
+      0.470f, 0.881f, 0.393f, 0.383f, 0.973f, 0.585f, 0.252f, 0.940f, 0.975f, 0.131f}},
+};
+const int colormapCount = sizeof(colormaps) / sizeof(colormaps[0]);
+
+// Writes one position/scalar vertex and returns the next write position
+inline float *emitScalarVertex(float *out, float x, float y, float z, float s) {
+  out[0] = x;
+  out[1] = y;
+  out[2] = z;
+  out[3] = s;
+  return out + 4;
+}
 
-  // Gravitational field parameters
-  float centralMass;
-  float maxDeformation;
+// Writes one planar (x, y) vertex with its color and returns the next write position
+inline float *emitPlanarVertex(float *out, float x, float y, float r, float g, float b) {
+  out[0] = x;
+  out[1] = y;
+  out[2] = r;
+  out[3] = g;
+  out[4] = b;
+  return out + 5;
+}
 
-  // Performance settings
-  int targetFPS;
-  float frameTime;
-  float lastFrameTime;
-  int qualityLevel;  // 0=Low, 1=Medium, 2=High, 3=Ultra
+// Writes one interleaved position/color vertex and returns the next write position
+inline float *emitVertex(float *out, float x, float y, float z, float r, float g, float b) {
+  out[0] = x;
+  out[1] = y;
+  out[2] = z;
+  out[3] = r;
+  out[4] = g;
+  out[5] = b;
+  return out + 6;
+}
 
-  // Window dimensions
-  int windowWidth, windowHeight;
+constexpr int qualityMultiplierForLevel(int level) { return level == 0 ? 1 : level == 1 ? 2 : level == 3 ? 8 : 4; }
+
+// Tessellation of the parametric surfaces fixed at compile time: segment counts
+// are the base counts times Quarters / 4. Generators written as templates over
+// the policy see their segment counts as constants, so loops get fixed trip
+// counts and per-level trig tables are built by the compiler. Levels run from a
+// quarter of the base counts to the 8x of Ultra quality; one is picked per frame
+// from the surface's size on screen.
+template <int Quarters>
+struct TessellationPolicy {
+  static constexpr int segments(int base) { return base * Quarters / 4; }
+};
 
-  // Camera parameters
-  glm::vec3 cameraPos;
-  glm::vec3 cameraFront;
-  glm::vec3 cameraUp;
-  glm::vec3 cameraRight;
-  glm::vec3 worldUp;
+const int tessellationLevels = 6;
+typedef TessellationPolicy<4 << (tessellationLevels - 3)> FinestTessellation;
+
+// sin usable in constant expressions (std::sin is not constexpr in C++17). The
+// argument is reduced to [-pi, pi], where 30 Taylor terms reach double precision.
+constexpr double constexprSin(double x) {
+  const double pi = 3.14159265358979323846;
+  x -= 2.0 * pi * (double)(long long)(x / (2.0 * pi));
+  if (x > pi) x -= 2.0 * pi;
+  if (x < -pi) x += 2.0 * pi;
+  double term = x, sum = x;
+  for (int n = 1; n < 30; ++n) {
+    term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+    sum += term;
+  }
+  return sum;
+}
 
-  // Mouse camera control
-  float yaw;
-  float pitch;
-  float mouseSensitivity;
-  float cameraSpeed;
-  bool firstMouse;
-  double lastX, lastY;
+constexpr double constexprCos(double x) { return constexprSin(x + 1.57079632679489661923); }
 
-  // Movement keys state
-  bool keys[1024];
+// cos and sin of 2 pi i / N for i = 0 .. N. Multiples of an angle index the
+// table modulo N; the extra entry serves closed grids that repeat the seam.
+template <int N>
+struct TrigTable {
+  float cos[N + 1], sin[N + 1];
 
-  // Camera movement timing
-  float deltaTime;
-  float lastFrame;
+  constexpr TrigTable() : cos(), sin() {
+    for (int i = 0; i <= N; ++i) {
+      double angle = 2.0 * 3.14159265358979323846 * i / N;
+      cos[i] = (float)constexprCos(angle);
+      sin[i] = (float)constexprSin(angle);
+    }
+  }
+};
 
-  // Background colors
-  std::vector<Color> backgrounds;
+template <int N>
+constexpr TrigTable<N> trigTable{};
 
+// Per-frame bump allocator for generator scratch data. Everything handed out is
+// released at once by reset(); if a frame overflows the current block, extra
+// blocks are chained and folded into one larger block on the next reset, so the
+// steady state performs no heap allocations.
+class FrameArena {
  public:
-  MathAnimation()
-      : time(0.0f),
-        animationMode(0),
-        backgroundMode(0),
-        windowWidth(1200),
-        windowHeight(900),
-        targetFPS(60),
-        qualityLevel(2),
-        yaw(-90.0f),
-        pitch(0.0f),
-        mouseSensitivity(0.1f),
-        cameraSpeed(2.5f),
-        firstMouse(true),
-        lastX(600.0),
-        lastY(450.0),
-        deltaTime(0.0f),
-        lastFrame(0.0f) {
-    // Initialize camera vectors
-    cameraPos = glm::vec3(0.0f, 0.0f, 5.0f);
-    worldUp = glm::vec3(0.0f, 1.0f, 0.0f);
-    updateCameraVectors();
+  explicit FrameArena(size_t initialCapacity = 1 << 20) : capacity(initialCapacity), offset(0), overflowBytes(0) {
+    block.reset(new unsigned char[capacity]);
+  }
 
-    // Initialize keys array
-    for (int i = 0; i < 1024; i++) {
-      keys[i] = false;
+  template <typename T>
+  T *alloc(size_t count) {
+    size_t bytes = count * sizeof(T);
+    size_t start = (offset + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    if (start + bytes <= capacity) {
+      offset = start + bytes;
+      return reinterpret_cast<T *>(block.get() + start);
     }
 
-    // Initialize background colors
-    backgrounds = {
-        Colors::DARK_BLUE,          // Deep blue
-        Colors::BLACK,              // Pure black
-        Colors::DARK_PURPLE,        // Dark purple
-        Colors::DARK_GREEN,         // Dark green
-        Color(0.1f, 0.1f, 0.15f),   // Dark gray-blue
-        Color(0.05f, 0.1f, 0.1f),   // Dark teal
-        Color(0.15f, 0.05f, 0.05f)  // Dark red
-    };
+    // Overflow: serve from a dedicated block until the next reset
+    overflow.emplace_back(new unsigned char[bytes]);
+    overflowBytes += bytes;
+    return reinterpret_cast<T *>(overflow.back().get());
   }
 
-  void updateCameraVectors() {
-    // Calculate the new front vector
-    glm::vec3 front;
-    front.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
-    front.y = sin(glm::radians(pitch));
-    front.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
-    cameraFront = glm::normalize(front);
-
-    // Re-calculate the right and up vector
-    cameraRight = glm::normalize(glm::cross(cameraFront, worldUp));
-    cameraUp = glm::normalize(glm::cross(cameraRight, cameraFront));
+  void reset() {
+    if (!overflow.empty()) {
+      capacity = std::max(capacity * 2, capacity + overflowBytes + overflow.size() * alignof(std::max_align_t));
+      block.reset(new unsigned char[capacity]);
+      overflow.clear();
+      overflowBytes = 0;
+    }
+    offset = 0;
   }
 
-  bool initialize() {
-    // Initialize GLFW
-    if (!glfwInit()) {
-      std::cerr << "Failed to initialize GLFW" << "\n";
-      return false;
-    }
+  size_t used() const { return offset + overflowBytes; }
 
-    // Configure GLFW
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+ private:
+  std::unique_ptr<unsigned char[]> block;
+  size_t capacity;
+  size_t offset;
+  std::vector<std::unique_ptr<unsigned char[]>> overflow;
+  size_t overflowBytes;
+};
 
-    // Create window
-    window = glfwCreateWindow(windowWidth, windowHeight, "Mathematical Functions Animation", NULL, NULL);
-    if (!window) {
-      std::cerr << "Failed to create GLFW window" << "\n";
-      glfwTerminate();
-      return false;
-    }
+// Adaptive parameter sampling for curves. The range [t0, t1] starts as
+// `initialSegments` uniform chords. The segment whose curve midpoint lies
+// furthest from its chord is split repeatedly until every chord is within
+// `tolerance` or `maxVertices` is reached. Flat arcs keep a few long chords and
+// cusps get dense sampling. Writes the parameters in increasing order and
+// returns their count; scratch memory comes from the frame arena.
+template <typename Curve>
+size_t adaptiveSample(const Curve &curve, float t0, float t1, size_t initialSegments, size_t maxVertices, float tolerance, float *params,
+                      FrameArena &arena) {
+  struct Segment {
+    float t0, t1;
+    glm::vec3 p0, p1;
+    float error;
+    bool operator<(const Segment &other) const { return error < other.error; }
+  };
+
+  auto makeSegment = [&curve](float a, float b, const glm::vec3 &pa, const glm::vec3 &pb) {
+    glm::vec3 mid = curve(0.5f * (a + b));
+    glm::vec3 chord = pb - pa;
+    float length2 = glm::dot(chord, chord);
+    float s = length2 > 0.0f ? glm::clamp(glm::dot(mid - pa, chord) / length2, 0.0f, 1.0f) : 0.0f;
+    return Segment{a, b, pa, pb, glm::length(mid - (pa + s * chord))};
+  };
+
+  size_t maxSegments = std::max<size_t>(maxVertices, 2) - 1;
+  initialSegments = std::max<size_t>(1, std::min(initialSegments, maxSegments));
+  Segment *heap = arena.alloc<Segment>(maxSegments);
+  size_t count = 0;
+
+  glm::vec3 previous = curve(t0);
+  for (size_t i = 0; i < initialSegments; ++i) {
+    float b = t0 + (t1 - t0) * (i + 1) / initialSegments;
+    glm::vec3 next = curve(b);
+    heap[count++] = makeSegment(t0 + (t1 - t0) * i / initialSegments, b, previous, next);
+    previous = next;
+  }
+  std::make_heap(heap, heap + count);
+
+  // Splitting the worst segment replaces it with two halves
+  while (count < maxSegments && heap[0].error > tolerance) {
+    std::pop_heap(heap, heap + count);
+    Segment worst = heap[count - 1];
+    float mid = 0.5f * (worst.t0 + worst.t1);
+    glm::vec3 pm = curve(mid);
+    heap[count - 1] = makeSegment(worst.t0, mid, worst.p0, pm);
+    std::push_heap(heap, heap + count);
+    heap[count] = makeSegment(mid, worst.t1, pm, worst.p1);
+    std::push_heap(heap, heap + ++count);
+  }
 
-    glfwMakeContextCurrent(window);
-    glfwSetWindowUserPointer(window, this);
-    glfwSetKeyCallback(window, keyCallback);
-    glfwSetCursorPosCallback(window, mouseCallback);
-    glfwSetScrollCallback(window, scrollCallback);
-    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+  for (size_t i = 0; i < count; ++i) params[i] = heap[i].t0;
+  std::sort(params, params + count);
+  params[count] = t1;
+  return count + 1;
+}
 
-    // Capture mouse cursor
-    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+// Persistent worker threads for data-parallel generator loops. parallelFor()
+// splits [0, count) into one contiguous chunk per thread, runs the last chunk on
+// the caller and returns once every chunk is done. Threads start on first use;
+// the body is passed by pointer, so a call does not allocate.
+class WorkerPool {
+ public:
+  WorkerPool() : generation(0), pending(0), count(0), context(NULL), invoke(NULL), stopping(false) {}
 
-    // Set VSync based on target FPS
-    if (targetFPS == 60) {
-      glfwSwapInterval(1);  // VSync on
-    } else {
-      glfwSwapInterval(0);  // VSync off for custom FPS
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
     }
+    wake.notify_all();
+    for (std::thread &thread : threads) thread.join();
+  }
 
-    // Initialize GLEW
-    if (glewInit() != GLEW_OK) {
-      std::cerr << "Failed to initialize GLEW" << "\n";
-      return false;
+  template <typename Body>
+  void parallelFor(int itemCount, const Body &body) {
+    if (threads.empty()) start();
+    const int chunks = (int)threads.size() + 1;
+    if (itemCount < chunks) {
+      body(0, itemCount);
+      return;
     }
 
-    // Configure OpenGL
-    glEnable(GL_DEPTH_TEST);
-    updateBackgroundColor();
-
-    // Create shader program
-    if (!createShaderProgram()) {
-      return false;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      count = itemCount;
+      context = &body;
+      invoke = [](const void *context, int begin, int end) { (*static_cast<const Body *>(context))(begin, end); };
+      pending = (int)threads.size();
+      generation++;
     }
+    wake.notify_all();
 
-    // Generate buffers
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    return true;
+    body(chunkBegin(chunks - 1, chunks, itemCount), itemCount);
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return pending == 0; });
   }
 
-  static void framebufferSizeCallback(GLFWwindow *window, int width, int height) {
-    MathAnimation *app = static_cast<MathAnimation *>(glfwGetWindowUserPointer(window));
-    app->windowWidth = width;
-    app->windowHeight = height;
-    glViewport(0, 0, width, height);
-  }
+  int threadCount() const { return (int)threads.size() + 1; }
 
-  static void mouseCallback(GLFWwindow *window, double xpos, double ypos) {
-    MathAnimation *app = static_cast<MathAnimation *>(glfwGetWindowUserPointer(window));
+ private:
+  static int chunkBegin(int chunk, int chunks, int itemCount) { return (int)((long long)itemCount * chunk / chunks); }
 
-    if (app->firstMouse) {
-      app->lastX = xpos;
-      app->lastY = ypos;
-      app->firstMouse = false;
+  void start() {
+    int workers = std::max(1, std::min((int)std::thread::hardware_concurrency() - 1, 15));
+    for (int i = 0; i < workers; ++i) threads.emplace_back([this, i] { work(i); });
+  }
+
+  void work(int index) {
+    unsigned seen = 0;
+    for (;;) {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+      if (stopping) return;
+      seen = generation;
+      const int chunks = (int)threads.size() + 1;
+      const int begin = chunkBegin(index, chunks, count), end = chunkBegin(index + 1, chunks, count);
+      const void *body = context;
+      void (*run)(const void *, int, int) = invoke;
+      lock.unlock();
+
+      run(body, begin, end);
+
+      lock.lock();
+      if (--pending == 0) done.notify_one();
     }
+  }
 
-    double xoffset = xpos - app->lastX;
-    double yoffset = app->lastY - ypos;  // Reversed since y-coordinates go from bottom to top
-    app->lastX = xpos;
-    app->lastY = ypos;
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable wake, done;
+  unsigned generation;
+  int pending;
+  int count;
+  const void *context;
+  void (*invoke)(const void *context, int begin, int end);
+  bool stopping;
+};
 
-    xoffset *= app->mouseSensitivity;
-    yoffset *= app->mouseSensitivity;
+// One background thread that runs a job at a time, so a slow generator does not
+// hold up input handling and drawing. submit() returns immediately; idle() polls
+// for the job to finish and wait() blocks until it has. The job is a plain
+// function and context pointer, so submitting does not allocate.
+class GenerationThread {
+ public:
+  GenerationThread() : run(NULL), context(NULL), pending(false), stopping(false) {}
 
-    app->yaw += xoffset;
-    app->pitch += yoffset;
+  ~GenerationThread() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_one();
+    if (thread.joinable()) thread.join();
+  }
 
-    // Constrain pitch
-    if (app->pitch > 89.0f) app->pitch = 89.0f;
-    if (app->pitch < -89.0f) app->pitch = -89.0f;
+  void submit(void (*job)(void *context), void *jobContext) {
+    if (!thread.joinable()) thread = std::thread([this] { work(); });
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      run = job;
+      context = jobContext;
+      pending = true;
+    }
+    wake.notify_one();
+  }
 
-    app->updateCameraVectors();
+  bool idle() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !pending;
   }
 
-  static void scrollCallback(GLFWwindow *window, double xoffset, double yoffset) {
-    MathAnimation *app = static_cast<MathAnimation *>(glfwGetWindowUserPointer(window));
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return !pending; });
+  }
 
-    // Adjust camera speed with scroll wheel
-    app->cameraSpeed += yoffset * 0.5f;
-    if (app->cameraSpeed < 0.5f) app->cameraSpeed = 0.5f;
-    if (app->cameraSpeed > 10.0f) app->cameraSpeed = 10.0f;
+ private:
+  void work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      wake.wait(lock, [this] { return stopping || pending; });
+      if (stopping) return;
+      lock.unlock();
+      run(context);
+      lock.lock();
+      pending = false;
+      done.notify_all();
+    }
+  }
 
-    std::cout << "Camera speed: " << app->cameraSpeed << "\n";
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable wake, done;
+  void (*run)(void *context);
+  void *context;
+  bool pending;
+  bool stopping;
+};
+
+// Eight floats operated on together: one AVX register when the build enables
+// AVX, otherwise a plain array the compiler may vectorize. Batched integrators
+// run the same templated code on float (one state) and on FloatLanes.
+struct FloatLanes {
+  static const int width = 8;
+#ifdef __AVX__
+  __m256 v;
+
+  static FloatLanes load(const float *p) { return {_mm256_loadu_ps(p)}; }
+  static FloatLanes broadcast(float x) { return {_mm256_set1_ps(x)}; }
+  void store(float *p) const { _mm256_storeu_ps(p, v); }
+
+  friend FloatLanes operator+(FloatLanes a, FloatLanes b) { return {_mm256_add_ps(a.v, b.v)}; }
+  friend FloatLanes operator-(FloatLanes a, FloatLanes b) { return {_mm256_sub_ps(a.v, b.v)}; }
+  friend FloatLanes operator*(FloatLanes a, FloatLanes b) { return {_mm256_mul_ps(a.v, b.v)}; }
+
+  // Largest |lane|
+  float maxMagnitude() const {
+    __m256 a = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v);
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    return _mm_cvtss_f32(m);
   }
+#else
+  float v[width];
 
-  static void keyCallback(GLFWwindow *window, int key, int scancode, int action, int mods) {
-    MathAnimation *app = static_cast<MathAnimation *>(glfwGetWindowUserPointer(window));
+  static FloatLanes load(const float *p) {
+    FloatLanes r;
+    for (int i = 0; i < width; ++i) r.v[i] = p[i];
+    return r;
+  }
+  static FloatLanes broadcast(float x) {
+    FloatLanes r;
+    for (int i = 0; i < width; ++i) r.v[i] = x;
+    return r;
+  }
+  void store(float *p) const {
+    for (int i = 0; i < width; ++i) p[i] = v[i];
+  }
 
-    // Handle key press/release for movement
-    if (key >= 0 && key < 1024) {
-      if (action == GLFW_PRESS)
-        app->keys[key] = true;
-      else if (action == GLFW_RELEASE)
-        app->keys[key] = false;
+  friend FloatLanes operator+(FloatLanes a, FloatLanes b) {
+    for (int i = 0; i < width; ++i) a.v[i] += b.v[i];
+    return a;
+  }
+  friend FloatLanes operator-(FloatLanes a, FloatLanes b) {
+    for (int i = 0; i < width; ++i) a.v[i] -= b.v[i];
+    return a;
+  }
+  friend FloatLanes operator*(FloatLanes a, FloatLanes b) {
+    for (int i = 0; i < width; ++i) a.v[i] *= b.v[i];
+    return a;
+  }
+
+  float maxMagnitude() const {
+    float m = 0.0f;
+    for (int i = 0; i < width; ++i) m = std::max(m, fabsf(v[i]));
+    return m;
+  }
+#endif
+
+  friend FloatLanes operator+(float a, FloatLanes b) { return broadcast(a) + b; }
+  friend FloatLanes operator-(float a, FloatLanes b) { return broadcast(a) - b; }
+  friend FloatLanes operator*(float a, FloatLanes b) { return broadcast(a) * b; }
+};
+
+inline float maxMagnitude(float x) { return fabsf(x); }
+inline float maxMagnitude(const FloatLanes &x) { return x.maxMagnitude(); }
+
+// ODE integration for the dynamical-system modes. A vector field is a functor
+//   static const int dimension;
+//   template <typename T> void operator()(const T *state, T *derivative) const;
+// evaluated with T = float for a single state or T = FloatLanes for a lane group
+// of states, so one definition serves the scalar and the batched steppers.
+struct LorenzField {
+  static const int dimension = 3;
+  float sigma, rho, beta;
+
+  template <typename T>
+  void operator()(const T *s, T *ds) const {
+    ds[0] = sigma * (s[1] - s[0]);
+    ds[1] = s[0] * (rho - s[2]) - s[1];
+    ds[2] = s[0] * s[1] - beta * s[2];
+  }
+};
+
+// Classic fourth-order Runge-Kutta step of size h
+template <typename Field, typename T>
+inline void rk4Step(const Field &field, T *state, float h) {
+  const int n = Field::dimension;
+  T k1[n], k2[n], k3[n], k4[n], probe[n];
+  field(state, k1);
+  for (int i = 0; i < n; ++i) probe[i] = state[i] + (0.5f * h) * k1[i];
+  field(probe, k2);
+  for (int i = 0; i < n; ++i) probe[i] = state[i] + (0.5f * h) * k2[i];
+  field(probe, k3);
+  for (int i = 0; i < n; ++i) probe[i] = state[i] + h * k3[i];
+  field(probe, k4);
+  for (int i = 0; i < n; ++i) state[i] = state[i] + (h / 6.0f) * (k1[i] + 2.0f * (k2[i] + k3[i]) + k4[i]);
+}
+
+// Adaptive Dormand-Prince 5(4) step. Shrinks h until the embedded fourth-order
+// error estimate (largest over components and lanes) is within `tolerance`,
+// advances the state by the fifth-order solution and leaves the suggested next
+// step, at most hMax, in h. Returns the step actually taken.
+template <typename Field, typename T>
+inline float dormandPrinceStep(const Field &field, T *state, float &h, float tolerance, float hMax) {
+  const int n = Field::dimension;
+  T k1[n], k2[n], k3[n], k4[n], k5[n], k6[n], k7[n], probe[n], next[n];
+  field(state, k1);
+  for (;;) {
+    for (int i = 0; i < n; ++i) probe[i] = state[i] + (h * (1.0f / 5.0f)) * k1[i];
+    field(probe, k2);
+    for (int i = 0; i < n; ++i) probe[i] = state[i] + h * ((3.0f / 40.0f) * k1[i] + (9.0f / 40.0f) * k2[i]);
+    field(probe, k3);
+    for (int i = 0; i < n; ++i) probe[i] = state[i] + h * ((44.0f / 45.0f) * k1[i] - (56.0f / 15.0f) * k2[i] + (32.0f / 9.0f) * k3[i]);
+    field(probe, k4);
+    for (int i = 0; i < n; ++i) {
+      probe[i] = state[i] + h * ((19372.0f / 6561.0f) * k1[i] - (25360.0f / 2187.0f) * k2[i] + (64448.0f / 6561.0f) * k3[i] -
+                                 (212.0f / 729.0f) * k4[i]);
+    }
+    field(probe, k5);
+    for (int i = 0; i < n; ++i) {
+      probe[i] = state[i] + h * ((9017.0f / 3168.0f) * k1[i] - (355.0f / 33.0f) * k2[i] + (46732.0f / 5247.0f) * k3[i] +
+                                 (49.0f / 176.0f) * k4[i] - (5103.0f / 18656.0f) * k5[i]);
+    }
+    field(probe, k6);
+    for (int i = 0; i < n; ++i) {
+      next[i] = state[i] + h * ((35.0f / 384.0f) * k1[i] + (500.0f / 1113.0f) * k3[i] + (125.0f / 192.0f) * k4[i] -
+                                (2187.0f / 6784.0f) * k5[i] + (11.0f / 84.0f) * k6[i]);
+    }
+    field(next, k7);
+
+    // Difference between the fifth- and fourth-order solutions
+    float error = 0.0f;
+    for (int i = 0; i < n; ++i) {
+      T e = h * ((71.0f / 57600.0f) * k1[i] - (71.0f / 16695.0f) * k3[i] + (71.0f / 1920.0f) * k4[i] - (17253.0f / 339200.0f) * k5[i] +
+                 (22.0f / 525.0f) * k6[i] - (1.0f / 40.0f) * k7[i]);
+      error = std::max(error, maxMagnitude(e));
     }
 
-    if (action == GLFW_PRESS) {
-      switch (key) {
-        // Numbers 1-9, 0 (functions 1-10)
-        case GLFW_KEY_1:
-          app->animationMode = 0;
-          break;  // Parametric spiral
-        case GLFW_KEY_2:
-          app->animationMode = 1;
-          break;  // Lissajous curve
-        case GLFW_KEY_3:
-          app->animationMode = 2;
-          break;  // 3D helix
-        case GLFW_KEY_4:
-          app->animationMode = 3;
-          break;  // Sine wave surface
-        case GLFW_KEY_5:
-          app->animationMode = 4;
-          break;  // Torus
-        case GLFW_KEY_6:
-          app->animationMode = 5;
-          break;  // Hypotrochoid
-        case GLFW_KEY_7:
-          app->animationMode = 6;
-          break;  // Superformula
-        case GLFW_KEY_8:
-          app->animationMode = 7;
-          break;  // Lorenz attractor
-        case GLFW_KEY_9:
-          app->animationMode = 8;
-          break;  // Klein Bottle
-        case GLFW_KEY_0:
-          app->animationMode = 9;
-          break;  // Gyroid Surface
-
-        // Letters Q-T (functions 11-15)
-        case GLFW_KEY_Q:
-          app->animationMode = 10;
-          break;            // Spherical Harmonic
-        case GLFW_KEY_TAB:  // Use TAB instead of W for fractal zoom to avoid conflict with movement
-          app->animationMode = 11;
-          break;  // Fractal Zoom
-        case GLFW_KEY_E:
-          app->animationMode = 12;
-          break;  // Phyllotaxis
-        case GLFW_KEY_R:
-          app->animationMode = 13;
-          break;  // Tesseract 4D Projection
-        case GLFW_KEY_T:
-          app->animationMode = 14;
-          break;  // Wave Interference Surface
-        case GLFW_KEY_G:
-          app->animationMode = 15;
-          break;  // Gravitational Spacetime Curvature
+    float scale = error > 0.0f ? 0.9f * powf(tolerance / error, 0.2f) : 5.0f;
+    if (error <= tolerance) {
+      for (int i = 0; i < n; ++i) state[i] = next[i];
+      float taken = h;
+      h = std::min(hMax, h * std::min(5.0f, scale));
+      return taken;
+    }
+    h *= std::max(0.2f, scale);
+  }
+}
 
-        // Mass control for gravitational field
-        case GLFW_KEY_EQUAL:   // '+' key (usually requires shift)
-        case GLFW_KEY_KP_ADD:  // Numpad +
-          app->increaseMass();
-          break;
-        case GLFW_KEY_MINUS:        // '-' key
-        case GLFW_KEY_KP_SUBTRACT:  // Numpad -
-          app->decreaseMass();
-          break;
+// Advances `count` states, stored component-wise as soa[c][0 .. count), by
+// `steps` RK4 steps. `count` is a multiple of FloatLanes::width; each lane group
+// stays in registers for all of its steps.
+template <typename Field>
+inline void rk4Batch(const Field &field, float *const *soa, int count, float h, int steps) {
+  const int n = Field::dimension;
+  for (int i = 0; i < count; i += FloatLanes::width) {
+    FloatLanes state[n];
+    for (int c = 0; c < n; ++c) state[c] = FloatLanes::load(soa[c] + i);
+    for (int step = 0; step < steps; ++step) rk4Step(field, state, h);
+    for (int c = 0; c < n; ++c) state[c].store(soa[c] + i);
+  }
+}
 
-        case GLFW_KEY_K:          // Reset and bring to the beginning position
-                app->cameraPos = glm::vec3(0.0f, 0.0f, 5.0f);  // Reset camera position
-                app->centralMass = 0.5f;
-                app->generateGravitationalSpacetime(app->vertices, 0.0f);
-                std::cout << "Reset Mass: " << app->centralMass << std::endl;
-                break;
+// Hot generator kernels, built once per x86 ISA level and selected at startup
+// from cpuid (or --isa=). Each body is written as fixed-width lane loops that
+// the vectorizer turns into SSE, AVX2 or AVX-512 code, depending on the target
+// of the wrapper it is inlined into; so the baseline build still runs wide
+// kernels on hosts that have them. Variants agree up to rounding: the AVX2 and
+// AVX-512 wrappers let the compiler contract multiply-adds into FMA.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_MULTIVERSION 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_BODY inline __attribute__((always_inline))
+#else
+#define SIMD_BODY inline
+#endif
+
+namespace SimdKernels {
+const int lanes = 16;  // Block width of every kernel loop, one AVX-512 register of floats
+
+// sin and cos of `count` angles: reduction by pi/2 in three parts, then minimax
+// polynomials on [-pi/4, pi/4]. Absolute error below 1e-7 for |angle| < 1000.
+SIMD_BODY void sinCosBody(const float *angles, int count, float *sines, float *cosines) {
+  for (int base = 0; base < count; base += lanes) {
+    const int width = std::min(lanes, count - base);
+    float x[lanes] = {}, s[lanes], c[lanes];
+    for (int l = 0; l < width; ++l) x[l] = angles[base + l];
+    for (int l = 0; l < lanes; ++l) {
+      const float q = x[l] * 0.636619772f + (x[l] >= 0.0f ? 0.5f : -0.5f);
+      const int quadrant = (int)q;
+      const float fq = (float)quadrant;
+      const float r = ((x[l] - fq * 1.5703125f) - fq * 4.837512969970703125e-4f) - fq * 7.549789948768648e-8f;
+      const float r2 = r * r;
+      const float ps = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+      const float pc = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+      const float sine = (quadrant & 1) ? pc : ps;
+      const float cosine = (quadrant & 1) ? ps : pc;
+      s[l] = (quadrant & 2) ? -sine : sine;
+      c[l] = ((quadrant + 1) & 2) ? -cosine : cosine;
+    }
+    for (int l = 0; l < width; ++l) sines[base + l] = s[l];
+    if (cosines) {
+      for (int l = 0; l < width; ++l) cosines[base + l] = c[l];
+    }
+  }
+}
+
+// Escape time of c = cr + i ci[j] for `count` points, as a fraction of
+// maxIterations. Every lane keeps iterating after it escapes (its z only grows,
+// and the alive mask stops its count), so the lane loop has no branches; a
+// block stops once all of its lanes have escaped.
+SIMD_BODY void mandelbrotRowBody(float cr, const float *ci, int count, int maxIterations, float *heights) {
+  for (int base = 0; base < count; base += lanes) {
+    const int width = std::min(lanes, count - base);
+    float zr[lanes] = {}, zi[lanes] = {}, im[lanes] = {}, iterations[lanes] = {};
+    int alive[lanes];
+    for (int l = 0; l < lanes; ++l) alive[l] = 1;
+    for (int l = 0; l < width; ++l) im[l] = ci[base + l];
+    for (int n = 0; n < maxIterations; ++n) {
+      int active = 0;
+      for (int l = 0; l < lanes; ++l) {
+        const float r2 = zr[l] * zr[l], i2 = zi[l] * zi[l];
+        alive[l] &= r2 + i2 < 4.0f;
+        iterations[l] += alive[l] ? 1.0f : 0.0f;
+        zi[l] = 2.0f * zr[l] * zi[l] + im[l];
+        zr[l] = r2 - i2 + cr;
+        active |= alive[l];
+      }
+      if (!active) break;
+    }
+    for (int l = 0; l < width; ++l) heights[base + l] = iterations[l] / maxIterations;
+  }
+}
 
+// Gyroid field sin x cos y + sin y cos z + sin z cos x along one z row of the grid
+SIMD_BODY void gyroidRowBody(float sinXCosY, float sinY, float cosX, const float *sinZ, const float *cosZ, int count, float *values) {
+  for (int base = 0; base < count; base += lanes) {
+    const int width = std::min(lanes, count - base);
+    float sz[lanes] = {}, cz[lanes] = {}, v[lanes];
+    for (int l = 0; l < width; ++l) {
+      sz[l] = sinZ[base + l];
+      cz[l] = cosZ[base + l];
+    }
+    for (int l = 0; l < lanes; ++l) v[l] = sinXCosY + sinY * cz[l] + sz[l] * cosX;
+    for (int l = 0; l < width; ++l) values[base + l] = v[l];
+  }
+}
 
-        // Performance controls
-        case GLFW_KEY_F1:
-          app->setTargetFPS(30);
-          break;  // 30 FPS
-        case GLFW_KEY_F2:
-          app->setTargetFPS(60);
-          break;  // 60 FPS
-        case GLFW_KEY_F3:
-          app->setTargetFPS(120);
-          break;  // 120 FPS
-        case GLFW_KEY_F4:
-          app->setTargetFPS(144);
-          break;  // 144 FPS
+// Rainbow palette base + amplitude sin(phase + 2 pi c / 3) for channels c = 0, 1, 2,
+// written to the color slots of `count` interleaved vertices
+SIMD_BODY void phaseColorsBody(const float *phases, int count, float base, float amplitude, float *vertices) {
+  float s[lanes], c[lanes];
+  for (int first = 0; first < count; first += lanes) {
+    const int width = std::min(lanes, count - first);
+    sinCosBody(phases + first, width, s, c);
+    for (int l = 0; l < width; ++l) {
+      float *color = vertices + (size_t)(first + l) * 6 + 3;
+      color[0] = base + amplitude * s[l];
+      color[1] = base + amplitude * (-0.5f * s[l] + 0.866025404f * c[l]);
+      color[2] = base + amplitude * (-0.5f * s[l] - 0.866025404f * c[l]);
+    }
+  }
+}
 
-        // Quality controls
-        case GLFW_KEY_F5:
-          app->setQuality(0);
-          break;  // Low quality
-        case GLFW_KEY_F6:
-          app->setQuality(1);
-          break;  // Medium quality
-        case GLFW_KEY_F7:
-          app->setQuality(2);
-          break;  // High quality
-        case GLFW_KEY_F8:
-          app->setQuality(3);
-          break;  // Ultra quality
+#define SIMD_VARIANTS(suffix, attributes)                                                                                                  \
+  attributes void sinCos##suffix(const float *angles, int count, float *sines, float *cosines) {                                           \
+    sinCosBody(angles, count, sines, cosines);                                                                                             \
+  }                                                                                                                                        \
+  attributes void mandelbrotRow##suffix(float cr, const float *ci, int count, int maxIterations, float *heights) {                         \
+    mandelbrotRowBody(cr, ci, count, maxIterations, heights);                                                                              \
+  }                                                                                                                                        \
+  attributes void gyroidRow##suffix(float sinXCosY, float sinY, float cosX, const float *sinZ, const float *cosZ, int count, float *values) { \
+    gyroidRowBody(sinXCosY, sinY, cosX, sinZ, cosZ, count, values);                                                                        \
+  }                                                                                                                                        \
+  attributes void phaseColors##suffix(const float *phases, int count, float base, float amplitude, float *vertices) {                       \
+    phaseColorsBody(phases, count, base, amplitude, vertices);                                                                             \
+  }
 
-        // Background color cycling
-        case GLFW_KEY_B:  // Cycle background colors
-          app->backgroundMode = (app->backgroundMode + 1) % app->backgrounds.size();
-          app->updateBackgroundColor();
-          break;
+SIMD_VARIANTS(Baseline, )
+#ifdef SIMD_MULTIVERSION
+SIMD_VARIANTS(Sse42, __attribute__((target("sse4.2"))))
+SIMD_VARIANTS(Avx2, __attribute__((target("avx2,fma"))))
+SIMD_VARIANTS(Avx512, __attribute__((target("avx512f,avx2,fma"))))
+#endif
+#undef SIMD_VARIANTS
+
+struct Variant {
+  const char *isa;     // Name accepted by --isa=
+  bool (*available)();  // CPU check, NULL for the baseline
+  void (*sinCos)(const float *angles, int count, float *sines, float *cosines);  // cosines may be NULL
+  void (*mandelbrotRow)(float cr, const float *ci, int count, int maxIterations, float *heights);
+  void (*gyroidRow)(float sinXCosY, float sinY, float cosX, const float *sinZ, const float *cosZ, int count, float *values);
+  void (*phaseColors)(const float *phases, int count, float base, float amplitude, float *vertices);
+};
 
-        case GLFW_KEY_V:  // Toggle VSync
-          app->toggleVSync();
-          break;
+// Ordered from narrowest to widest
+const Variant variants[] = {
+    {"baseline", NULL, sinCosBaseline, mandelbrotRowBaseline, gyroidRowBaseline, phaseColorsBaseline},
+#ifdef SIMD_MULTIVERSION
+    {"sse4.2", [] { return (bool)__builtin_cpu_supports("sse4.2"); }, sinCosSse42, mandelbrotRowSse42, gyroidRowSse42, phaseColorsSse42},
+    {"avx2", [] { return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"); }, sinCosAvx2, mandelbrotRowAvx2, gyroidRowAvx2,
+     phaseColorsAvx2},
+    {"avx512", [] { return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"); },
+     sinCosAvx512, mandelbrotRowAvx512, gyroidRowAvx512, phaseColorsAvx512},
+#endif
+};
+const int variantCount = sizeof(variants) / sizeof(variants[0]);
+
+const Variant *active = &variants[0];
+
+// Activates the widest variant this CPU supports, or the one named `isa` when it
+// is not NULL. Returns false if that name is unknown or unsupported here.
+inline bool select(const char *isa) {
+#ifdef SIMD_MULTIVERSION
+  __builtin_cpu_init();
+#endif
+  for (int i = variantCount - 1; i >= 0; --i) {
+    const bool available = !variants[i].available || variants[i].available();
+    if (isa ? strcmp(variants[i].isa, isa) != 0 : !available) continue;
+    if (!available) {
+      std::cerr << "This CPU does not support the " << isa << " kernels" << "\n";
+      return false;
+    }
+    active = &variants[i];
+    return true;
+  }
+  std::cerr << "Unknown ISA: " << isa << " (expected";
+  for (int i = 0; i < variantCount; ++i) std::cerr << " " << variants[i].isa;
+  std::cerr << ")" << "\n";
+  return false;
+}
+}  // namespace SimdKernels
+
+// Loads and unloads shared libraries with the platform loader
+#ifdef _WIN32
+static void *openLibrary(const std::string &path) { return (void *)LoadLibraryA(path.c_str()); }
+static void *librarySymbol(void *library, const char *name) { return (void *)GetProcAddress((HMODULE)library, name); }
+static void closeLibrary(void *library) { FreeLibrary((HMODULE)library); }
+static std::string libraryError() { return "error " + std::to_string(GetLastError()); }
+static const char *const libraryExtension = ".dll";
+#else
+static void *openLibrary(const std::string &path) { return dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL); }
+static void *librarySymbol(void *library, const char *name) { return dlsym(library, name); }
+static void closeLibrary(void *library) { dlclose(library); }
+static std::string libraryError() {
+  const char *error = dlerror();
+  return error ? error : "unknown error";
+}
+static const char *const libraryExtension = ".so";
+#endif
+
+// Reports files written in one directory: inotify on Linux, modification-time
+// polling twice a second elsewhere. poll() is cheap enough to call every frame.
+// With inotify it does not allocate unless something changed; the polling scan
+// walks the directory with std::filesystem, which allocates on every scan.
+class FileWatcher {
+ public:
+  FileWatcher() : fd(-1), watchDescriptor(-1), lastScan(0.0) {}
+  FileWatcher(const FileWatcher &) = delete;
+  FileWatcher &operator=(const FileWatcher &) = delete;
+
+  ~FileWatcher() {
+#ifdef __linux__
+    if (fd >= 0) close(fd);
+#endif
+  }
 
-        // Mouse cursor toggle
-        case GLFW_KEY_M:  // Toggle mouse cursor
-          app->toggleMouseCursor();
-          break;
+  bool watch(const std::string &dir) {
+    directory = dir;
+#ifdef __linux__
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) return false;
+    // Compilers either rewrite the file in place or rename a finished file over it
+    watchDescriptor = inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    return watchDescriptor >= 0;
+#else
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(dir, error)) {
+      stamps[entry.path().filename().string()] = entry.last_write_time(error);
+    }
+    return !error;
+#endif
+  }
 
-        // Exit application
-        case GLFW_KEY_ESCAPE:
-          glfwSetWindowShouldClose(window, true);
-          break;
+  // Appends the names of files changed since the last call; returns true if any changed
+  bool poll(std::vector<std::string> &changed) {
+    size_t before = changed.size();
+#ifdef __linux__
+    if (fd < 0) return false;
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+      for (char *p = buffer; p < buffer + length;) {
+        const inotify_event *event = reinterpret_cast<const inotify_event *>(p);
+        if (event->len > 0 && std::find(changed.begin(), changed.end(), event->name) == changed.end()) {
+          changed.push_back(event->name);
+        }
+        p += sizeof(inotify_event) + event->len;
+      }
+    }
+#else
+    double now = glfwGetTime();
+    if (directory.empty() || now - lastScan < 0.5) return false;
+    lastScan = now;
+
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error)) {
+      std::filesystem::file_time_type stamp = entry.last_write_time(error);
+      if (error) continue;
+      std::string name = entry.path().filename().string();
+      auto found = stamps.find(name);
+      if (found == stamps.end()) {
+        changed.push_back(name);
+        stamps.emplace(std::move(name), stamp);
+      } else if (found->second != stamp) {
+        found->second = stamp;
+        changed.push_back(found->first);
       }
     }
+#endif
+    return changed.size() > before;
   }
 
-  void increaseMass() {
-        centralMass += 0.2f;
-        if (centralMass > 5.0f) centralMass = 5.0f;
-        std::cout << "Central Mass: " << centralMass << std::endl;
+  const std::string &path() const { return directory; }
+
+ private:
+  std::string directory;
+  int fd;
+  int watchDescriptor;
+  double lastScan;
+  std::unordered_map<std::string, std::filesystem::file_time_type> stamps;
+};
+
+// Generator plugins loaded from a directory of shared libraries (see
+// generator_plugin.h). Each library is loaded from a private copy, so the
+// original can be rebuilt while the application runs; a changed library is
+// loaded next to the old one and only replaces it once it validates.
+class PluginHost {
+ public:
+  struct Plugin {
+    std::string file;        // Library name inside the plugin directory
+    std::string loadedCopy;  // Private copy actually loaded
+    void *library = NULL;
+    const ManimGeneratorPlugin *api = NULL;
+    std::string name;
+  };
+
+  PluginHost() : copyCounter(0) {}
+  PluginHost(const PluginHost &) = delete;
+  PluginHost &operator=(const PluginHost &) = delete;
+  ~PluginHost() { unloadAll(); }
+
+  // Loads every library in `dir` and starts watching it; returns the number loaded
+  size_t loadDirectory(const std::string &dir) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(dir, error)) return 0;
+
+    std::vector<std::string> files;
+    for (const auto &entry : std::filesystem::directory_iterator(dir, error)) {
+      if (entry.path().extension() == libraryExtension) files.push_back(entry.path().filename().string());
     }
-    
-    void decreaseMass() {
-        centralMass -= 0.2f;
-        if (centralMass < 0.1f) centralMass = 0.1f;
-        std::cout << "Central Mass: " << centralMass << std::endl;
+    std::sort(files.begin(), files.end());
+
+    directory = dir;
+    watcher.watch(dir);
+    for (const std::string &file : files) load(file);
+    return plugins.size();
+  }
+
+  // Collects libraries written since the last call, without loading them; returns
+  // true if applyChanges() has work to do
+  bool detectChanges() {
+    changedFiles.clear();
+    if (!watcher.poll(changedFiles)) return false;
+    changedFiles.erase(std::remove_if(changedFiles.begin(), changedFiles.end(),
+                                      [](const std::string &file) { return std::filesystem::path(file).extension() != libraryExtension; }),
+                       changedFiles.end());
+    return !changedFiles.empty();
+  }
+
+  // Reloads the libraries found by detectChanges() and loads new ones, unloading
+  // replaced versions; returns true if any plugin changed
+  bool applyChanges() {
+    bool reloaded = false;
+    for (const std::string &file : changedFiles) reloaded |= load(file);
+    changedFiles.clear();
+    return reloaded;
+  }
+
+  size_t count() const { return plugins.size(); }
+  const Plugin &operator[](size_t index) const { return *plugins[index]; }
+
+  void unloadAll() {
+    for (auto &plugin : plugins) unload(*plugin);
+    plugins.clear();
+  }
+
+ private:
+  // Loads `file` into a new slot or over the existing plugin of the same name.
+  // A library that fails to load or validate leaves the old version in place.
+  bool load(const std::string &file) {
+    std::error_code error;
+    std::filesystem::path source = std::filesystem::path(directory) / file;
+    std::filesystem::path copy = std::filesystem::temp_directory_path(error) /
+                                 ("manim-plugin-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "-" +
+                                  std::to_string(copyCounter++) + libraryExtension);
+    if (!std::filesystem::copy_file(source, copy, std::filesystem::copy_options::overwrite_existing, error)) {
+      std::cerr << "Plugin " << file << ": could not copy library: " << error.message() << "\n";
+      return false;
     }
 
+    Plugin candidate;
+    candidate.file = file;
+    candidate.loadedCopy = copy.string();
+    candidate.library = openLibrary(candidate.loadedCopy);
+    if (!candidate.library) {
+      std::cerr << "Plugin " << file << ": " << libraryError() << "\n";
+      std::filesystem::remove(copy, error);
+      return false;
+    }
 
-  void toggleMouseCursor() {
-    static bool cursorEnabled = false;
-    cursorEnabled = !cursorEnabled;
+    ManimGeneratorPluginEntry entry = (ManimGeneratorPluginEntry)librarySymbol(candidate.library, MANIM_PLUGIN_ENTRY_SYMBOL);
+    candidate.api = entry ? entry() : NULL;
+    if (!candidate.api || candidate.api->abiVersion != MANIM_PLUGIN_ABI_VERSION || !candidate.api->name || !candidate.api->maxVertices ||
+        !candidate.api->generate) {
+      std::cerr << "Plugin " << file << ": missing " << MANIM_PLUGIN_ENTRY_SYMBOL << " or ABI version mismatch (expected "
+                << MANIM_PLUGIN_ABI_VERSION << ")\n";
+      unload(candidate);
+      return false;
+    }
+    candidate.name = candidate.api->name;
+
+    for (auto &plugin : plugins) {
+      if (plugin->file != file) continue;
+      unload(*plugin);
+      *plugin = std::move(candidate);
+      std::cout << "Reloaded plugin: " << plugin->name << "\n";
+      return true;
+    }
 
-    if (cursorEnabled) {
-      glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-      std::cout << "Mouse cursor enabled (camera control disabled)" << "\n";
-    } else {
-      glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-      firstMouse = true;  // Reset mouse to avoid jump
-      std::cout << "Mouse cursor disabled (camera control enabled)" << "\n";
+    plugins.emplace_back(new Plugin(std::move(candidate)));
+    std::cout << "Loaded plugin: " << plugins.back()->name << "\n";
+    return true;
+  }
+
+  void unload(Plugin &plugin) {
+    if (plugin.library) closeLibrary(plugin.library);
+    plugin.library = NULL;
+    plugin.api = NULL;
+    std::error_code error;
+    if (!plugin.loadedCopy.empty()) std::filesystem::remove(plugin.loadedCopy, error);
+  }
+
+  std::string directory;
+  FileWatcher watcher;
+  std::vector<std::string> changedFiles;
+  // Slots are heap allocated so registry entries can keep pointers to plugin names
+  std::vector<std::unique_ptr<Plugin>> plugins;
+  unsigned copyCounter;
+};
+
+// On-disk cache of linked program binaries (glGetProgramBinary). Entries are keyed
+// by a hash of the shader sources and feedback varyings together with the
+// driver's vendor, renderer and version strings, so an edited shader or a driver
+// update misses and recompiles instead of loading a stale binary.
+class ProgramBinaryCache {
+ public:
+  ProgramBinaryCache() : supported(false), hits(0), misses(0) {}
+
+  // Requires a current context
+  void initialize(const std::string &dir) {
+    directory = dir;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    supported = (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) && formats > 0;
+    if (!supported) return;
+
+    for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+      const GLubyte *value = glGetString(name);
+      driver += value ? reinterpret_cast<const char *>(value) : "";
+      driver += '\n';
     }
+    std::error_code error;
+    std::filesystem::create_directories(dir, error);
   }
 
-  void processInput() {
-    float velocity = cameraSpeed * deltaTime;
+  bool enabled() const { return supported; }
+
+  uint64_t key(const std::string &sources) const { return fnv1a(driver, fnv1a(sources)); }
+
+  // Returns a linked program for `key`, or 0 on a miss
+  GLuint load(const std::string &name, uint64_t key) {
+    if (!supported) return 0;
+    std::string path = entryPath(name, key);
+    std::ifstream in(path, std::ios::binary);
+    uint32_t header[3];  // magic, binary format, length
+    if (!in.read(reinterpret_cast<char *>(header), sizeof(header)) || header[0] != magic) {
+      misses++;
+      return 0;
+    }
+    // A corrupt or truncated entry is a miss, checked before the length is trusted
+    std::error_code error;
+    uintmax_t fileSize = std::filesystem::file_size(path, error);
+    if (error || fileSize != sizeof(header) + (uintmax_t)header[2]) {
+      misses++;
+      return 0;
+    }
+    std::vector<char> binary(header[2]);
+    if (!in.read(binary.data(), binary.size())) {
+      misses++;
+      return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header[1], binary.data(), (GLsizei)binary.size());
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+      // The driver rejected its own binary; rebuild the entry from source
+      glDeleteProgram(program);
+      misses++;
+      return 0;
+    }
+    hits++;
+    return program;
+  }
+
+  // Saves a program linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT, replacing
+  // older entries for the same program
+  void store(const std::string &name, uint64_t key, GLuint program) {
+    if (!supported) return;
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, NULL, &format, binary.data());
+
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error)) {
+      if (entry.path().filename().string().rfind(name + "-", 0) == 0) std::filesystem::remove(entry.path(), error);
+    }
+
+    std::ofstream out(entryPath(name, key), std::ios::binary);
+    uint32_t header[3] = {magic, format, (uint32_t)length};
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    out.write(binary.data(), binary.size());
+  }
+
+  size_t hitCount() const { return hits; }
+  size_t missCount() const { return misses; }
+
+ private:
+  static constexpr uint32_t magic = 0x3142504d;  // "MPB1"
+
+  static uint64_t fnv1a(const std::string &data, uint64_t hash = 14695981039346656037ull) {
+    for (unsigned char c : data) {
+      hash ^= c;
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  std::string entryPath(const std::string &name, uint64_t key) const {
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)key);
+    return (std::filesystem::path(directory) / (name + "-" + hex + ".bin")).string();
+  }
+
+  std::string directory;
+  std::string driver;
+  bool supported;
+  size_t hits, misses;
+};
+
+class MathAnimation {
+ private:
+  // One entry per animation mode. Key bindings, buffer sizes, draw path and
+  // regeneration are all derived from this table rather than mode numbers.
+  typedef size_t (MathAnimation::*GenerateFn)(float *out, float t);
+
+  // Parametric surface with one generator instantiation per tessellation level
+  struct SurfaceLod {
+    const GenerateFn *kernels;  // TessellationPolicy levels 0 .. tessellationLevels - 1
+    float radius;               // Bounding sphere around the model origin
+    float chordError;           // Largest world-space chord error at level 0; each level quarters it
+  };
+
+  struct GeneratorInfo {
+    const char *name;
+    int key;  // GLFW key that selects the mode
+    const char *keyLabel;
+    DrawPath path;
+    GLenum primitive;
+    bool timeDependent;  // If false, regenerate only when quality or inputs change
+    bool stableTopology;  // Same vertex count and vertex order every frame, so keyframes can be blended
+    CostClass cost;
+    size_t (*maxVertices)(int qualityMult);                   // Vertices, grid vertices or cells written
+    size_t (MathAnimation::*generate)(float *out, float t);    // Vertices, static grid or heights
+    GLuint MathAnimation::*program;                           // Program for GPU paths
+    void (MathAnimation::*setUniforms)(GLuint program, float t);  // Mode-specific uniforms, optional
+    HeightfieldMesh MathAnimation::*mesh;                     // GpuHeightfield grid
+    HeightStream MathAnimation::*stream;                      // HeightStream target
+    size_t stripLength;  // CpuVertices: vertices per strip when the output is several strips, else 0
+    const SurfaceLod *lod;  // Parametric surfaces: tessellated per frame, replacing generate
+    float pointExtent;    // GL_POINTS: world-space size of the sampled domain, for sprite sizing
+    int pointDimensions;  // GL_POINTS: 2 for grids and sheets, 3 for volumes
+  };
+
+  // Shader programs built from files in the shader directory
+  struct ShaderProgramInfo {
+    const char *label;
+    const char *vertexFile;
+    const char *fragmentFile;     // NULL for programs that only run transform feedback
+    const char *feedbackVarying;  // Output captured by transform feedback, optional
+    GLuint MathAnimation::*program;
+    bool deferred;  // Only GPU paths use it, so it is built after the first frame
+  };
+
+  static const ShaderProgramInfo shaderPrograms[];
+  static const int shaderProgramCount;
+
+  // Built-in modes; the active registry appends one entry per loaded plugin
+  static const GeneratorInfo builtinGenerators[];
+  static const int builtinGeneratorCount;
+  std::vector<GeneratorInfo> generators;
+
+  // Generator plugins, reloaded when their library is rebuilt. The initial scan
+  // runs on a background thread started after the first frame.
+  PluginHost pluginHost;
+  std::thread pluginLoader;
+  std::atomic<bool> pluginsLoaded;
+  double pluginLoadMs;
+
+  GLFWwindow *window;
+  int headlessFrames;  // Frames to render into a hidden window before exiting (--headless); 0 when interactive
+  bool assertNoAlloc;  // Headless run checks every mode for steady-state heap allocations (--assert-no-alloc)
+  GLuint shaderProgram;
+  GLuint VAO, VBO;
+
+  // Planar modes share VBO through a VAO with a 2D position attribute; the
+  // orthographic view (O) also turns off depth testing for them
+  GLuint planarProgram;
+  GLuint planarVAO;
+  bool planarOrtho;
+
+  // Scalar-colored modes read the VBO as (x, y, z, s) through their own VAO; the
+  // colormap texture is rebuilt when another map is selected (Y)
+  GLuint scalarProgram;
+  GLuint scalarVAO;
+  GLuint scalarColormap;
+  int colormapIndex;
+
+  // Line strips are drawn as screen-space quads, one instance per segment, reading
+  // the VBO through a texture buffer view; width (, and .) and join style (I) are
+  // adjustable. Buffers too large for a texture buffer fall back to GL lines.
+  GLuint polylineProgram;
+  GLuint polylineVAO;
+  GLuint polylineTexture;
+  GLint maxTextureBufferTexels;
+  float lineWidth;
+  bool lineMiter;
+
+  // CPU point clouds are drawn as sprites through any of the three VAOs
+  GLuint pointProgram;
+  bool additivePoints;
+
+  // Point heightfields draw only the chunks in the view frustum, thinned with
+  // distance (/ toggles, for comparison)
+  bool heightfieldLod;
+
+  // Restart-separated strip indices for multi-strip CPU modes, bound to VAO
+  GLuint stripIndexBuffer;
+  size_t stripIndexCount, stripIndexLength;
+
+  // Threads for generators that split their work (the Lorenz ensemble)
+  WorkerPool workers;
+
+  // Heightfield modes (sine surface, wave interference, spacetime)
+  GLuint sineSurfaceProgram, waveInterferenceProgram, spacetimeProgram;
+  HeightfieldMesh sineSurfaceMesh, waveInterferenceMesh, spacetimeMesh;
+
+  // Height-only streaming path for CPU-computed grids (fractal zoom)
+  GLuint heightStreamProgram;
+  HeightStream fractalStream;
+  HeightStream deepZoomStream;
+  ReferenceOrbit deepZoomOrbit;
+  // Iteration limit for a zoom depth in decimal digits; the deepest view is 30
+  static int deepZoomIterations(double depth) { return 200 + (int)(10.0 * depth); }
+  vector<float> heightCells;
+
+  // Fragment-shader fractal; flat by default, terrain (H) and Julia (J) optional
+  GLuint fractalProgram, fractalTerrainProgram;
+  GpuFractal gpuFractal;
+  bool fractalTerrain;
+  bool fractalJulia;
+
+  // GPU particle engine for the attractor mode
+  GLuint particleUpdateProgram, particleProgram;
+  ParticleSystem particles;
+
+  // Shader files are watched and relinked on change; linked binaries are cached on disk
+  FileWatcher shaderWatcher;
+  std::vector<std::string> changedShaderFiles;
+  ProgramBinaryCache programCache;
+  std::vector<int> shaderBuildOrder;  // Table indices, programs the first frame needs before the deferred ones
+  int programsBuilt;                  // Programs built so far, in shaderBuildOrder
+  double shaderBuildMs;
+
+  StartupProfile startup;
+
+  // Vertex storage is presized to the current mode's vertex count and only grows
+  vector<float> vertices;
+  size_t vertexCount;
+  bool generationDirty;  // Forces regeneration of modes that are not time dependent
+  FrameArena frameArena;  // Generator scratch, reset by each generation job
+
+  // Keyframe interpolation (F10): stable-topology modes are generated keyframeRate
+  // times a second into VBO and keyframeVBO, and their shaders blend the pair by
+  // keyframeMix (the weight of keyframeVBO) on the frames in between
+  bool keyframesEnabled;
+  double keyframeRate;
+  GLuint keyframeVBO;
+  GLuint keyframeTexture;  // Polyline view of keyframeVBO
+  KeyframePair keyframes;
+  float keyframeMix;
+
+  // Animation parameters
+  float time;
+  int animationMode;
+  int backgroundMode;
+
+  // Gravitational field parameters
+  float centralMass;
+  float maxDeformation;
+
+  // Vector field advected by the GPU particle engine (index into attractorFields)
+  int attractorField;
+
+  // Hypotrochoid ratio R/r is snapped to p/q with q at most this, so the curve closes
+  int hypotrochoidMaxDenominator;
+  HypotrochoidPeriod hypotrochoidPeriod;
+
+  // Performance settings
+  int targetFPS;
+  float frameTime;
+  float lastFrameTime;
+  int qualityLevel;  // 0=Low, 1=Medium, 2=High, 3=Ultra
+  int tessellationLevel;  // Parametric surfaces: level of the geometry on screen
+
+  // Generation runs on its own thread. A job generates one mode at one time into
+  // the staging storage (vertices or heightCells), using the frame arena for
+  // scratch; the render thread uploads the result once the job is done and keeps
+  // drawing the last uploaded geometry, with a fresh camera, until then. Anything
+  // a generator reads is only changed after waitForGeneration().
+  struct GenerationJob {
+    GeneratorInfo generator;
+    float t;
+    long long keyframe;  // Keyframe index, or -1
+    // The view the error tolerance is computed for, as of the job's start
+    glm::vec3 eye;
+    int viewportHeight;
+    bool ortho;
+    // Results
+    int tessellationLevel;
+    size_t count;  // Vertices or cells written
+    double ms;
+  };
+  GenerationJob generationJob;
+  GenerationThread generationThread;
+  bool generationPending;  // A job was submitted and its result not yet taken
+
+  // Input-to-present latency: time from the first input event a frame's camera
+  // includes to the return of that frame's buffer swap
+  double inputPendingSince;  // glfwGetTime() of the oldest input not yet latched, or -1
+
+  // Frame telemetry, printed once per second while enabled (F9)
+  bool telemetryEnabled;
+  double telemetryWindowStart;
+  int telemetryFrames;
+  double telemetryFrameMs, telemetryMaxFrameMs, telemetryGenerateMs;
+  double telemetryLatencyMs, telemetryMaxLatencyMs;
+  int telemetryLatencyFrames;
+  size_t telemetryUploadBytes, telemetryAllocations, telemetryAllocatedBytes, telemetryPeakLiveBytes;
+
+  // Heap accounting for the current frame and per animation mode
+  size_t frameStartAllocations, frameStartAllocatedBytes;
+  std::vector<ModeMemoryStats> modeMemory;
+
+  // GPU buffer storage owned by the renderer
+  GpuBufferTracker gpuBuffers;
+
+  // Window dimensions
+  int windowWidth, windowHeight;
+
+  // Camera parameters
+  glm::vec3 cameraPos;
+  glm::vec3 cameraFront;
+  glm::vec3 cameraUp;
+  glm::vec3 cameraRight;
+  glm::vec3 worldUp;
+
+  // Mouse camera control
+  float yaw;
+  float pitch;
+  float mouseSensitivity;
+  float cameraSpeed;
+  bool firstMouse;
+  double lastX, lastY;
+
+  // Movement keys state
+  bool keys[1024];
+
+  // Camera movement timing
+  float deltaTime;
+  float lastFrame;
+
+  // Background colors
+  std::vector<Color> backgrounds;
+
+ public:
+  MathAnimation()
+      : pluginsLoaded(false),
+        pluginLoadMs(0.0),
+        headlessFrames(0),
+        assertNoAlloc(false),
+        planarVAO(0),
+        planarOrtho(false),
+        scalarVAO(0),
+        scalarColormap(0),
+        colormapIndex(0),
+        polylineVAO(0),
+        polylineTexture(0),
+        maxTextureBufferTexels(0),
+        lineWidth(2.0f),
+        lineMiter(false),
+        additivePoints(false),
+        heightfieldLod(true),
+        stripIndexBuffer(0),
+        stripIndexCount(0),
+        stripIndexLength(0),
+        fractalTerrain(false),
+        fractalJulia(false),
+        programsBuilt(0),
+        shaderBuildMs(0.0),
+        vertexCount(0),
+        generationDirty(true),
+        keyframesEnabled(false),
+        keyframeRate(30.0),
+        keyframeVBO(0),
+        keyframeTexture(0),
+        keyframeMix(0.0f),
+        time(0.0f),
+        animationMode(0),
+        backgroundMode(0),
+        centralMass(0.5f),
+        maxDeformation(1.0f),
+        attractorField(0),
+        hypotrochoidMaxDenominator(16),
+        windowWidth(1200),
+        windowHeight(900),
+        targetFPS(60),
+        qualityLevel(2),
+        tessellationLevel(4),
+        generationPending(false),
+        inputPendingSince(-1.0),
+        telemetryEnabled(false),
+        telemetryWindowStart(0.0),
+        telemetryFrames(0),
+        telemetryFrameMs(0.0),
+        telemetryMaxFrameMs(0.0),
+        telemetryGenerateMs(0.0),
+        telemetryLatencyMs(0.0),
+        telemetryMaxLatencyMs(0.0),
+        telemetryLatencyFrames(0),
+        telemetryUploadBytes(0),
+        telemetryAllocations(0),
+        telemetryAllocatedBytes(0),
+        telemetryPeakLiveBytes(0),
+        frameStartAllocations(0),
+        frameStartAllocatedBytes(0),
+        yaw(-90.0f),
+        pitch(0.0f),
+        mouseSensitivity(0.1f),
+        cameraSpeed(2.5f),
+        firstMouse(true),
+        lastX(600.0),
+        lastY(450.0),
+        deltaTime(0.0f),
+        lastFrame(0.0f) {
+    generators.assign(builtinGenerators, builtinGenerators + builtinGeneratorCount);
+    for (int i = 0; i < shaderProgramCount; ++i) this->*shaderPrograms[i].program = 0;
+    for (bool deferred : {false, true}) {
+      for (int i = 0; i < shaderProgramCount; ++i) {
+        if (shaderPrograms[i].deferred == deferred) shaderBuildOrder.push_back(i);
+      }
+    }
+
+    // Initialize camera vectors
+    cameraPos = glm::vec3(0.0f, 0.0f, 5.0f);
+    worldUp = glm::vec3(0.0f, 1.0f, 0.0f);
+    updateCameraVectors();
+
+    // Initialize keys array
+    for (int i = 0; i < 1024; i++) {
+      keys[i] = false;
+    }
+
+    // Initialize background colors
+    backgrounds = {
+        Colors::DARK_BLUE,          // Deep blue
+        Colors::BLACK,              // Pure black
+        Colors::DARK_PURPLE,        // Dark purple
+        Colors::DARK_GREEN,         // Dark green
+        Color(0.1f, 0.1f, 0.15f),   // Dark gray-blue
+        Color(0.05f, 0.1f, 0.1f),   // Dark teal
+        Color(0.15f, 0.05f, 0.05f)  // Dark red
+    };
+  }
+
+  void updateCameraVectors() {
+    // Calculate the new front vector
+    glm::vec3 front;
+    front.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
+    front.y = sin(glm::radians(pitch));
+    front.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
+    cameraFront = glm::normalize(front);
+
+    // Re-calculate the right and up vector
+    cameraRight = glm::normalize(glm::cross(cameraFront, worldUp));
+    cameraUp = glm::normalize(glm::cross(cameraRight, cameraFront));
+  }
+
+  // Times CPU generation of every built-in CPU mode at each quality level, best
+  // of `repetitions` runs at a fixed time. Needs no window or GL context.
+  void runBenchmark(int repetitions) {
+    const float t = 1.7f;
+    printf("Generator benchmark, ms (best of %d, %s kernels)\n", repetitions, SimdKernels::active->isa);
+    printf("  %-34s %9s %9s %9s %9s\n", "mode", "Low", "Medium", "High", "Ultra");
+    for (int mode = 0; mode < builtinGeneratorCount; ++mode) {
+      const GeneratorInfo &generator = generators[mode];
+      if (!generatesVertices(generator) && generator.path != DrawPath::HeightStream) continue;
+      latchGenerationView(generator);
+
+      printf("  %-34s", generator.name);
+      for (int level = 0; level < 4; ++level) {
+        qualityLevel = level;
+        size_t maxVertices = generator.maxVertices(getQualityMultiplier());
+        if (generator.path == DrawPath::HeightStream && heightCells.size() < maxVertices) heightCells.resize(maxVertices);
+
+        double best = 1e30;
+        for (int run = 0; run < repetitions; ++run) {
+          frameArena.reset();
+          auto start = std::chrono::steady_clock::now();
+          if (generator.path != DrawPath::HeightStream) {
+            generateInto(generator, t, level + 2);  // Surfaces at the quality's multiplier, as before they picked their own
+          } else {
+            (this->*generator.generate)(heightCells.data(), t);
+          }
+          best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        printf(" %9.3f", best);
+      }
+      printf("\n");
+    }
+  }
+
+  // Renders `frames` frames into a hidden window, reports their timing and exits
+  void setHeadless(int frames) { headlessFrames = std::max(1, frames); }
+
+  // Makes the headless run an allocation check of every built-in mode
+  void setAssertNoAlloc() {
+    assertNoAlloc = true;
+    if (!headlessFrames) setHeadless(300);
+  }
+
+  // Starts in the mode whose key label matches (e.g. "U" or "TAB"); false if none does
+  bool setStartMode(const char *keyLabel) {
+    for (int mode = 0; mode < builtinGeneratorCount; ++mode) {
+      if (strcmp(builtinGenerators[mode].keyLabel, keyLabel) == 0) {
+        animationMode = mode;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Starts with keyframe interpolation on at `rate` keyframes a second
+  void setKeyframes(double rate) {
+    keyframesEnabled = true;
+    keyframeRate = std::max(1.0, rate);
+  }
+
+  bool initialize() {
+    // Initialize GLFW
+    if (!glfwInit()) {
+      std::cerr << "Failed to initialize GLFW" << "\n";
+      return false;
+    }
+    startup.mark("glfwInit");
+
+    // Configure GLFW
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    // Headless runs use a hidden window, e.g. on llvmpipe under xvfb-run
+    if (headlessFrames) glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    // Create window
+    window = glfwCreateWindow(windowWidth, windowHeight, "Mathematical Functions Animation", NULL, NULL);
+    if (!window) {
+      std::cerr << "Failed to create GLFW window" << "\n";
+      glfwTerminate();
+      return false;
+    }
+
+    glfwMakeContextCurrent(window);
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetCursorPosCallback(window, mouseCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+
+    // Capture mouse cursor
+    if (!headlessFrames) glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    startup.mark("window");
+
+    // Set VSync based on target FPS
+    if (targetFPS == 60 && !headlessFrames) {
+      glfwSwapInterval(1);  // VSync on
+    } else {
+      glfwSwapInterval(0);  // VSync off for custom FPS
+    }
+
+    // Initialize GLEW
+    if (glewInit() != GLEW_OK) {
+      std::cerr << "Failed to initialize GLEW" << "\n";
+      return false;
+    }
+    startup.mark("glewInit");
+
+    // Configure OpenGL
+    glEnable(GL_DEPTH_TEST);
+    updateBackgroundColor();
+
+    // Create the shader programs the first frame needs, from the binary cache when possible
+    programCache.initialize(shaderCacheDirectory());
+    if (!createShaderProgram()) {
+      return false;
+    }
+    shaderWatcher.watch(shaderDirectory());
+    startup.mark("shaders");
+
+    // Generate buffers; the interleaved layout never changes, only the storage
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+    // Position attribute
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(0);
+
+    // Color attribute
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void *)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    // Planar layout over the same buffer: (x, y) and color
+    glGenVertexArrays(1, &planarVAO);
+    glBindVertexArray(planarVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void *)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    // Scalar layout: position and one colormap coordinate
+    glGenVertexArrays(1, &scalarVAO);
+    glBindVertexArray(scalarVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    // The second keyframe, in the same three layouts at locations 2 and 3. These are
+    // only enabled while keyframes are blended and otherwise read as zero.
+    glGenBuffers(1, &keyframeVBO);
+    glGenTextures(1, &keyframeTexture);
+    const GLuint layouts[3] = {VAO, planarVAO, scalarVAO};
+    const int positionComponents[3] = {3, 2, 3}, colorComponents[3] = {3, 3, 1};
+    for (int i = 0; i < 3; ++i) {
+      GLsizei stride = (positionComponents[i] + colorComponents[i]) * sizeof(float);
+      glBindVertexArray(layouts[i]);
+      glBindBuffer(GL_ARRAY_BUFFER, keyframeVBO);
+      glVertexAttribPointer(2, positionComponents[i], GL_FLOAT, GL_FALSE, stride, (void *)0);
+      glVertexAttribPointer(3, colorComponents[i], GL_FLOAT, GL_FALSE, stride, (void *)(positionComponents[i] * sizeof(float)));
+    }
+
+    // Polylines pull vertices from a texture buffer view of VBO and need no attributes
+    glGenVertexArrays(1, &polylineVAO);
+    glGenTextures(1, &polylineTexture);
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTextureBufferTexels);
+
+    if (!ensureProgramsFor(generators[animationMode])) return false;
+    presizeForMode();
+    startup.mark("buffers");
+
+    return true;
+  }
+
+  static void framebufferSizeCallback(GLFWwindow *window, int width, int height) {
+    MathAnimation *app = static_cast<MathAnimation *>(glfwGetWindowUserPointer(window));
+    app->windowWidth = width;
+    app->windowHeight = height;
+    glViewport(0, 0, width, height);
+  }
+
+  static void mouseCallback(GLFWwindow *window, double xpos, double ypos) {
+    MathAnimation *app = static_cast<MathAnimation *>(glfwGetWindowUserPointer(window));
+    app->noteInput();
+
+    if (app->firstMouse) {
+      app->lastX = xpos;
+      app->lastY = ypos;
+      app->firstMouse = false;
+    }
+
+    double xoffset = xpos - app->lastX;
+    double yoffset = app->lastY - ypos;  // Reversed since y-coordinates go from bottom to top
+    app->lastX = xpos;
+    app->lastY = ypos;
+
+    xoffset *= app->mouseSensitivity;
+    yoffset *= app->mouseSensitivity;
+
+    app->yaw += xoffset;
+    app->pitch += yoffset;
+
+    // Constrain pitch
+    if (app->pitch > 89.0f) app->pitch = 89.0f;
+    if (app->pitch < -89.0f) app->pitch = -89.0f;
+
+    app->updateCameraVectors();
+  }
+
+  static void scrollCallback(GLFWwindow *window, double xoffset, double yoffset) {
+    MathAnimation *app = static_cast<MathAnimation *>(glfwGetWindowUserPointer(window));
+
+    // Adjust camera speed with scroll wheel
+    app->cameraSpeed += yoffset * 0.5f;
+    if (app->cameraSpeed < 0.5f) app->cameraSpeed = 0.5f;
+    if (app->cameraSpeed > 10.0f) app->cameraSpeed = 10.0f;
+
+    std::cout << "Camera speed: " << app->cameraSpeed << "\n";
+  }
+
+  static void keyCallback(GLFWwindow *window, int key, int scancode, int action, int mods) {
+    MathAnimation *app = static_cast<MathAnimation *>(glfwGetWindowUserPointer(window));
+
+    // Handle key press/release for movement
+    if (action != GLFW_REPEAT) app->noteInput();
+    if (key >= 0 && key < 1024) {
+      if (action == GLFW_PRESS)
+        app->keys[key] = true;
+      else if (action == GLFW_RELEASE)
+        app->keys[key] = false;
+    }
+
+    if (action == GLFW_PRESS) {
+      // Mode keys come from the generator registry
+      for (int mode = 0; mode < (int)app->generators.size(); ++mode) {
+        if (app->generators[mode].key == key) {
+          app->selectMode(mode);
+          return;
+        }
+      }
+
+      switch (key) {
+        // Mass control for gravitational field
+        case GLFW_KEY_EQUAL:   // '+' key (usually requires shift)
+        case GLFW_KEY_KP_ADD:  // Numpad +
+          app->increaseMass();
+          break;
+        case GLFW_KEY_MINUS:        // '-' key
+        case GLFW_KEY_KP_SUBTRACT:  // Numpad -
+          app->decreaseMass();
+          break;
+
+        case GLFW_KEY_K:          // Reset and bring to the beginning position
+                app->cameraPos = glm::vec3(0.0f, 0.0f, 5.0f);  // Reset camera position
+                app->centralMass = 0.5f;
+                std::cout << "Reset Mass: " << app->centralMass << std::endl;
+                break;
+
+
+        // Performance controls
+        case GLFW_KEY_F1:
+          app->setTargetFPS(30);
+          break;  // 30 FPS
+        case GLFW_KEY_F2:
+          app->setTargetFPS(60);
+          break;  // 60 FPS
+        case GLFW_KEY_F3:
+          app->setTargetFPS(120);
+          break;  // 120 FPS
+        case GLFW_KEY_F4:
+          app->setTargetFPS(144);
+          break;  // 144 FPS
+
+        // Quality controls
+        case GLFW_KEY_F5:
+          app->setQuality(0);
+          break;  // Low quality
+        case GLFW_KEY_F6:
+          app->setQuality(1);
+          break;  // Medium quality
+        case GLFW_KEY_F7:
+          app->setQuality(2);
+          break;  // High quality
+        case GLFW_KEY_F8:
+          app->setQuality(3);
+          break;  // Ultra quality
+
+        // Background color cycling
+        case GLFW_KEY_B:  // Cycle background colors
+          app->backgroundMode = (app->backgroundMode + 1) % app->backgrounds.size();
+          app->updateBackgroundColor();
+          break;
+
+        case GLFW_KEY_V:  // Toggle VSync
+          app->toggleVSync();
+          break;
+
+        case GLFW_KEY_L:  // Vector field for the particle engine
+          app->cycleAttractorField();
+          break;
+        case GLFW_KEY_LEFT_BRACKET:  // Hypotrochoid period bound
+          app->setHypotrochoidMaxDenominator(app->hypotrochoidMaxDenominator - 1);
+          break;
+        case GLFW_KEY_RIGHT_BRACKET:
+          app->setHypotrochoidMaxDenominator(app->hypotrochoidMaxDenominator + 1);
+          break;
+
+        case GLFW_KEY_H:  // GPU fractal: flat view or heightmap terrain
+          app->toggleFractalTerrain();
+          break;
+        case GLFW_KEY_J:  // GPU fractal: Mandelbrot or Julia set
+          app->toggleFractalJulia();
+          break;
+        case GLFW_KEY_O:  // Planar modes: perspective camera or orthographic 2D view
+          app->togglePlanarOrtho();
+          break;
+        case GLFW_KEY_Y:  // Colormap for scalar-colored modes
+          app->cycleColormap();
+          break;
+
+        case GLFW_KEY_COMMA:  // Line width in pixels
+          app->setLineWidth(app->lineWidth - 1.0f);
+          break;
+        case GLFW_KEY_PERIOD:
+          app->setLineWidth(app->lineWidth + 1.0f);
+          break;
+        case GLFW_KEY_I:  // Line joins: round or miter
+          app->toggleLineJoins();
+          break;
+        case GLFW_KEY_SEMICOLON:  // Point sprites: alpha or additive blending
+          app->toggleAdditivePoints();
+          break;
+        case GLFW_KEY_SLASH:  // Heightfield chunk culling and LOD
+          app->toggleHeightfieldLod();
+          break;
+
+        case GLFW_KEY_N:  // Generator plugins
+          app->cyclePluginMode();
+          break;
+
+        case GLFW_KEY_F9:  // Toggle frame/memory telemetry
+          app->toggleTelemetry();
+          break;
+        case GLFW_KEY_F10:  // Keyframe interpolation for stable-topology modes
+          app->toggleKeyframes();
+          break;
+
+        // Mouse cursor toggle
+        case GLFW_KEY_M:  // Toggle mouse cursor
+          app->toggleMouseCursor();
+          break;
+
+        // Exit application
+        case GLFW_KEY_ESCAPE:
+          glfwSetWindowShouldClose(window, true);
+          break;
+      }
+    }
+  }
+
+  void increaseMass() {
+        centralMass += 0.2f;
+        if (centralMass > 5.0f) centralMass = 5.0f;
+        std::cout << "Central Mass: " << centralMass << std::endl;
+    }
+    
+    void decreaseMass() {
+        centralMass -= 0.2f;
+        if (centralMass < 0.1f) centralMass = 0.1f;
+        std::cout << "Central Mass: " << centralMass << std::endl;
+    }
+
+
+  void toggleMouseCursor() {
+    static bool cursorEnabled = false;
+    cursorEnabled = !cursorEnabled;
+
+    if (cursorEnabled) {
+      glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+      std::cout << "Mouse cursor enabled (camera control disabled)" << "\n";
+    } else {
+      glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+      firstMouse = true;  // Reset mouse to avoid jump
+      std::cout << "Mouse cursor disabled (camera control enabled)" << "\n";
+    }
+  }
+
+  // Starts the input-to-present clock unless an earlier event is still waiting for a frame
+  void noteInput() {
+    if (inputPendingSince < 0.0) inputPendingSince = glfwGetTime();
+  }
+
+  void processInput() {
+    float velocity = cameraSpeed * deltaTime;
+
+    if (keys[GLFW_KEY_W]) cameraPos += cameraFront * velocity;
+    if (keys[GLFW_KEY_S]) cameraPos -= cameraFront * velocity;
+    if (keys[GLFW_KEY_A]) cameraPos -= cameraRight * velocity;
+    if (keys[GLFW_KEY_D]) cameraPos += cameraRight * velocity;
+    if (keys[GLFW_KEY_SPACE]) cameraPos += cameraUp * velocity;
+    if (keys[GLFW_KEY_LEFT_SHIFT] || keys[GLFW_KEY_C]) cameraPos -= cameraUp * velocity;
+  }
+
+  void updateBackgroundColor() {
+    const Color &bg = backgrounds[backgroundMode];
+    glClearColor(bg.r, bg.g, bg.b, 1.0f);
+  }
+
+  void setTargetFPS(int fps) {
+    targetFPS = fps;
+    frameTime = 1.0f / fps;
+
+    // Update VSync based on FPS
+    if (fps == 60) {
+      glfwSwapInterval(1);  // VSync on for 60 FPS
+    } else {
+      glfwSwapInterval(0);  // VSync off for custom FPS
+    }
+
+    std::cout << "Target FPS set to: " << fps << "\n";
+  }
+
+  void setQuality(int quality) {
+    waitForGeneration();
+    qualityLevel = quality;
+    presizeForMode();
+    const char *qualityNames[] = {"Low", "Medium", "High", "Ultra"};
+    std::cout << "Quality set to: " << qualityNames[quality] << "\n";
+  }
+
+  void toggleVSync() {
+    static bool vsyncEnabled = true;
+    vsyncEnabled = !vsyncEnabled;
+    glfwSwapInterval(vsyncEnabled ? 1 : 0);
+    std::cout << "VSync " << (vsyncEnabled ? "enabled" : "disabled") << "\n";
+  }
+
+  int getQualityMultiplier() { return qualityMultiplier(qualityLevel); }
+
+  // Low 1x, Medium 2x, High 4x, Ultra 8x
+  static int qualityMultiplier(int level) { return qualityMultiplierForLevel(level); }
+
+  // Placeholder for missing math functions
+  float sph_legendre(int l, int m, float x) {
+    // Simplified spherical harmonic - just use sine/cosine approximation
+    return sin(l * acos(x) + m * 0.5f);
+  }
+
+  // Each generator has a count function reporting the exact number of vertices it
+  // writes for a quality multiplier (an upper bound for the gyroid, whose point
+  // count depends on the level set). Generators write through a raw pointer
+  // into storage presized from that count and return the vertices written.
+
+  static size_t countParametricSpiral(int qualityMult) { return 1000 * qualityMult; }
+
+  size_t generateParametricSpiral(float *out, float t) {
+    const int numPoints = countParametricSpiral(getQualityMultiplier());
+
+    for (int i = 0; i < numPoints; ++i) {
+      float param = (float)i / numPoints * 10.0f * M_PI;
+      float radius = 0.8f + 0.4f * sin(param * 0.1f + t);
+
+      float x = radius * cos(param + t);
+      float y = sin(param * 0.3f + t * 0.5f) * 0.5f;
+      float z = radius * sin(param + t);
+
+      float r = 0.6f + 0.4f * sin(param * 0.2f + t);
+      float g = 0.6f + 0.4f * cos(param * 0.15f + t * 1.5f);
+      float b = 0.6f + 0.4f * sin(param * 0.3f + t * 0.8f);
+
+      out = emitVertex(out, x, y, z, r, g, b);
+    }
+    return numPoints;
+  }
+
+  static size_t countLissajous(int qualityMult) { return 2000 * qualityMult; }
+
+  size_t generateLissajous(float *out, float t) {
+    const int numPoints = countLissajous(getQualityMultiplier());
+
+    // Axis angles as three runs of numPoints for the batched sine; the color
+    // channels are one phase rotated by thirds of a turn
+    float *angles = frameArena.alloc<float>(numPoints * 3);
+    float *sines = frameArena.alloc<float>(numPoints * 3);
+    float *phases = frameArena.alloc<float>(numPoints);
+    for (int i = 0; i < numPoints; ++i) {
+      float param = (float)i / numPoints * 4.0f * M_PI;
+      angles[i] = 3.0f * param + t;
+      angles[numPoints + i] = 2.0f * param + t * 0.7f;
+      angles[2 * numPoints + i] = 5.0f * param + t * 1.3f;
+      phases[i] = param + t;
+    }
+    SimdKernels::active->sinCos(angles, numPoints * 3, sines, NULL);
+
+    for (int i = 0; i < numPoints; ++i) {
+      out[6 * i] = 1.2f * sines[i];
+      out[6 * i + 1] = 1.0f * sines[numPoints + i];
+      out[6 * i + 2] = 0.8f * sines[2 * numPoints + i];
+    }
+    SimdKernels::active->phaseColors(phases, numPoints, 0.7f, 0.3f, out);
+    return numPoints;
+  }
+
+  static size_t count3DHelix(int qualityMult) { return 1500 * qualityMult; }
+
+  size_t generate3DHelix(float *out, float t) {
+    const int numPoints = count3DHelix(getQualityMultiplier());
+
+    for (int i = 0; i < numPoints; ++i) {
+      float param = (float)i / numPoints * 12.0f * M_PI;
+      float amplitude = 1.0f + 0.3f * sin(t * 2.0f);
+
+      float x = amplitude * cos(param + t);
+      float y = (param / (6.0f * M_PI) - 1.0f) * 1.5f;
+      float z = amplitude * sin(param + t);
+
+      out = emitScalarVertex(out, x, y, z, (float)i / numPoints);
+    }
+    return numPoints;
+  }
+
+  static int sineWaveGridSize(int qualityMult) { return 80 * sqrt(qualityMult); }
+
+  static size_t countSineWaveSurface(int qualityMult) { return sineWaveGridSize(qualityMult) * sineWaveGridSize(qualityMult); }
+
+  // Heightfield modes keep only a static x/z grid on the GPU, rebuilt when the
+  // quality level changes. Height and color are evaluated in the mode's vertex
+  // shader (see drawHeightfield). Grid vertices are (x, z, aux).
+  size_t buildSineWaveGrid(float *out, float) {
+    const int gridSize = sineWaveGridSize(getQualityMultiplier());
+    const float scale = 3.0f;
+    sineSurfaceMesh.heightBound = 0.6f;  // Amplitude in sine_surface.vert
+
+    for (int i = 0; i < gridSize; ++i) {
+      for (int j = 0; j < gridSize; ++j) {
+        out[0] = (float)i / gridSize * scale - scale / 2;
+        out[1] = (float)j / gridSize * scale - scale / 2;
+        out[2] = 0.0f;
+        out += 3;
+      }
+    }
+    return gridSize * gridSize;
+  }
+
+  // Parametric surfaces are presized for their finest tessellation
+  static size_t countTorus(int) { return FinestTessellation::segments(60) * FinestTessellation::segments(40); }
+
+  // Angles come from compile-time tables; the time offsets are folded in with
+  // angle-sum identities, so the inner loop has no trig calls
+  template <typename Tessellation>
+  size_t generateTorus(float *out, float t) {
+    constexpr int majorSegments = Tessellation::segments(60);
+    constexpr int minorSegments = Tessellation::segments(40);
+    const TrigTable<majorSegments> &major = trigTable<majorSegments>;
+    const TrigTable<minorSegments> &minor = trigTable<minorSegments>;
+    const float majorRadius = 1.2f;
+    const float minorRadius = 0.4f + 0.2f * sin(t * 2.0f);
+    const float cosT = cosf(t), sinT = sinf(t), cos17T = cosf(1.7f * t), sin17T = sinf(1.7f * t);
+
+    for (int i = 0; i < majorSegments; ++i) {
+      // u = 2 pi i / majorSegments + t
+      const float cosU = major.cos[i] * cosT - major.sin[i] * sinT;
+      const float sinU = major.sin[i] * cosT + major.cos[i] * sinT;
+      const float cosW = major.cos[i] * cos17T - major.sin[i] * sin17T;  // u + 0.7t
+      const float sinW = major.sin[i] * cos17T + major.cos[i] * sin17T;
+
+      for (int j = 0; j < minorSegments; ++j) {
+        const float cosV = minor.cos[j], sinV = minor.sin[j];
+        const float ring = majorRadius + minorRadius * cosV;
+
+        // Colormap coordinate follows sin(u + v + 0.7t)
+        out = emitScalarVertex(out, ring * cosU, minorRadius * sinV, ring * sinU, 0.5f + 0.5f * (sinW * cosV + cosW * sinV));
+      }
+    }
+    return majorSegments * minorSegments;
+  }
+
+  static const GenerateFn torusKernels[];
+  static const SurfaceLod torusLod;
+
+  static size_t countHypotrochoid(int qualityMult) { return 2000 * qualityMult; }
+
+  // Spreads the vertex budget over exactly one closed period. R/r is snapped to the
+  // simplest p/q within a small tolerance (q bounded by hypotrochoidMaxDenominator),
+  // so the curve closes after q turns. The snapped ratio is kept while R/r stays
+  // within the tolerance; otherwise the figure would change lobe count every frame
+  // as R and r drift. The trig tables for the period are cached while p/q and the
+  // budget are unchanged.
+  size_t generateHypotrochoid(float *out, float t) {
+    const size_t numPoints = countHypotrochoid(getQualityMultiplier());
+    const float R = 1.0f + 0.3f * sin(t * 0.5f);
+    const float r = 0.3f + 0.1f * cos(t * 0.7f);
+    const float d = 0.5f + 0.2f * sin(t * 1.3f);
+
+    // Moves R by at most 0.05 r (a few pixels at the default camera distance)
+    const double ratioTolerance = 0.05;
+    HypotrochoidPeriod &period = hypotrochoidPeriod;
+    int p = period.p, q = period.q;
+    if (q == 0 || q > hypotrochoidMaxDenominator || std::fabs(R / r - (double)p / q) > ratioTolerance) {
+      simplestRationalNear(R / r, ratioTolerance, hypotrochoidMaxDenominator, p, q);
+    }
+
+    if (period.p != p || period.q != q || period.points != numPoints) {
+      period.p = p;
+      period.q = q;
+      period.points = numPoints;
+      period.cosTheta.resize(numPoints);
+      period.sinTheta.resize(numPoints);
+      period.cosKTheta.resize(numPoints);
+      period.sinKTheta.resize(numPoints);
+
+      // The last vertex lands on theta = 2 pi q, closing the loop
+      const double k = (double)(p - q) / q;
+      for (size_t i = 0; i < numPoints; ++i) {
+        double θ = (double)i / (numPoints - 1) * 2.0 * M_PI * q;
+        period.cosTheta[i] = cos(θ);
+        period.sinTheta[i] = sin(θ);
+        period.cosKTheta[i] = cos(k * θ);
+        period.sinKTheta[i] = sin(k * θ);
+      }
+    }
+
+    // R - r for the snapped ratio; hue follows theta + t, expanded with the angle sum identity
+    const float diff = r * (p - q) / q;
+    const float cosR = cos(t), sinR = sin(t);
+    const float cosG = cos(t + 2.0f), sinG = sin(t + 2.0f);
+    const float cosB = cos(t + 4.0f), sinB = sin(t + 4.0f);
+    for (size_t i = 0; i < numPoints; ++i) {
+      float c = period.cosTheta[i], s = period.sinTheta[i];
+      float x = diff * c + d * period.cosKTheta[i];
+      float y = diff * s - d * period.sinKTheta[i];
+      out = emitPlanarVertex(out, x, y, 0.5f + 0.5f * (s * cosR + c * sinR), 0.5f + 0.5f * (s * cosG + c * sinG),
+                             0.5f + 0.5f * (s * cosB + c * sinB));
+    }
+    return numPoints;
+  }
+
+  // Object-space length covering `pixels` on screen at the camera's distance from
+  // the origin, or from the nearest point of a sphere of `radius` around it; the
+  // error target for adaptive curve sampling and surface tessellation. Reads the
+  // view the generation job started with.
+  float objectSpaceTolerance(float pixels, float radius = 0.0f) const {
+    const GenerationJob &job = generationJob;
+    if (job.ortho) return pixels * 2.0f * planarOrthoExtent / job.viewportHeight;
+    float distance = std::max(glm::length(job.eye) - radius, 0.5f);
+    float pixelsPerUnit = job.viewportHeight / (2.0f * distance * tanf(glm::radians(45.0f) * 0.5f));
+    return pixels / pixelsPerUnit;
+  }
+
+  // Vertex budget; the adaptive sampler usually stops well short of it
+  static size_t countSuperformula(int qualityMult) { return 1000 * qualityMult + 1; }
+
+  size_t generateSuperformula(float *out, float t) {
+    const int qualityMult = getQualityMultiplier();
+    float m = 6.0f + 4.0f * sin(t * 0.4f);
+    float n1 = 0.3f + 1.2f * fabs(sin(t * 0.6f));
+    float n2 = 1.0f + 2.0f * fabs(cos(t * 0.5f));
+    float n3 = 1.0f + 2.0f * fabs(sin(t * 0.8f));
+    const float a = 1, b = 1;
+
+    auto radius = [=](float φ) {
+      float cos_m = cos(m * φ / 4.0f) / a;
+      float sin_m = sin(m * φ / 4.0f) / b;
+      return powf(powf(fabs(cos_m), n2) + powf(fabs(sin_m), n3), -1.0f / n1);
+    };
+    auto curve = [&radius](float φ) {
+      float r = radius(φ);
+      return glm::vec3(r * cos(φ), r * sin(φ), 0.0f);
+    };
+
+    // Sub-pixel chord error, tighter at higher quality levels
+    size_t budget = countSuperformula(qualityMult);
+    float *params = frameArena.alloc<float>(budget);
+    size_t numPoints = adaptiveSample(curve, 0.0f, 2.0f * M_PI, 64, budget, objectSpaceTolerance(1.0f / qualityMult), params, frameArena);
+
+    for (size_t i = 0; i < numPoints; ++i) {
+      float φ = params[i];
+      float r = radius(φ);
+      out = emitPlanarVertex(out, r * cos(φ), r * sin(φ), 0.5f + 0.5f * r, 0.3f + 0.7f * (1 - r), 0.5f + 0.5f * sin(t + φ));
+    }
+    return numPoints;
+  }
+
+  // Integration steps; emitted vertices are a subset of these
+  static size_t countLorenzAttractor(int qualityMult) { return 5000 * qualityMult + 1; }
+
+  // The trajectory is integrated with fixed RK4 steps, but a point is only
+  // emitted once the arc since the last vertex could stray from its chord by more
+  // than the tolerance. Arc length times accumulated turning angle / 4 bounds that
+  // distance. Slow, straight stretches collapse to a few vertices while tight
+  // turns keep every step.
+  size_t generateLorenzAttractor(float *out, float t) {
+    const int qualityMult = getQualityMultiplier();
+    const int steps = countLorenzAttractor(qualityMult) - 1;
+    const float tolerance = objectSpaceTolerance(1.0f / qualityMult) / 0.1f;  // Attractor space is scaled by 0.1
+    const float dt = 0.005f;
+    const LorenzField field = {10.0f + 5.0f * sinf(t * 0.3f), 28.0f + 10.0f * cosf(t * 0.5f), 8.0f / 3.0f};
+    float state[3] = {0.1f, 0.0f, 0.0f};
+
+    // Colored by speed through the field
+    auto emit = [&out](const float *p, float speed) {
+      out = emitScalarVertex(out, p[0] * 0.1f, p[1] * 0.1f - 0.5f, p[2] * 0.1f - 0.5f, fminf(1.0f, speed * 0.05f));
+    };
+
+    size_t emitted = 0;
+    float previous[3] = {state[0], state[1], state[2]}, previousSpeed = 0.0f;
+    glm::vec3 previousDir(0.0f);
+    float arcLength = 0.0f, turning = 0.0f;
+
+    for (int i = 0; i < steps; ++i) {
+      float derivative[3];
+      field(state, derivative);
+      float speed = sqrtf(derivative[0] * derivative[0] + derivative[1] * derivative[1] + derivative[2] * derivative[2]);
+      rk4Step(field, state, dt);
+
+      glm::vec3 step(state[0] - previous[0], state[1] - previous[1], state[2] - previous[2]);
+      float length = glm::length(step);
+      glm::vec3 dir = length > 0.0f ? step / length : previousDir;
+      if (i == 0) {
+        emit(state, speed);
+        ++emitted;
+      } else {
+        arcLength += length;
+        turning += acosf(glm::clamp(glm::dot(dir, previousDir), -1.0f, 1.0f));
+        if (arcLength * turning * 0.25f > tolerance) {
+          // The previous point is the last one the chord from the last vertex still fits
+          emit(previous, previousSpeed);
+          ++emitted;
+          arcLength = length;
+          turning = 0.0f;
+        }
+      }
+      previous[0] = state[0], previous[1] = state[1], previous[2] = state[2];
+      previousSpeed = speed;
+      previousDir = dir;
+    }
+    emit(previous, previousSpeed);
+    return emitted + 1;
+  }
+
+  // 128 trajectories at Low up to 1024 at Ultra, each a strip of lorenzEnsembleLength points
+  static int lorenzEnsembleSize(int qualityMult) { return 128 * qualityMult; }
+  static const int lorenzEnsembleLength = 400;
+  static const int lorenzEnsembleSubsteps = 4;
+
+  static size_t countLorenzEnsemble(int qualityMult) { return (size_t)lorenzEnsembleSize(qualityMult) * lorenzEnsembleLength; }
+
+  // Sensitivity to initial conditions: trajectories start in a ball of radius
+  // 1e-3 and follow one path until the separation grows past the attractor's size
+  // near the end of the strip. States live in structure-of-arrays form so each
+  // step advances a lane group at once; the pool's threads take contiguous runs
+  // of lane groups and write their trajectories' vertices directly.
+  size_t generateLorenzEnsemble(float *out, float t) {
+    const int trajectories = lorenzEnsembleSize(getQualityMultiplier());
+    const float dt = 0.0125f;  // 20 time units per strip
+    const LorenzField field = {10.0f + 5.0f * sinf(t * 0.3f), 28.0f + 10.0f * cosf(t * 0.5f), 8.0f / 3.0f};
+
+    float *x = frameArena.alloc<float>(trajectories);
+    float *y = frameArena.alloc<float>(trajectories);
+    float *z = frameArena.alloc<float>(trajectories);
+    float *color = frameArena.alloc<float>(trajectories * 3);
+    for (int k = 0; k < trajectories; ++k) {
+      // Fibonacci sphere around the single trajectory's starting point
+      float cosPolar = 1.0f - 2.0f * (k + 0.5f) / trajectories;
+      float sinPolar = sqrtf(1.0f - cosPolar * cosPolar);
+      float azimuth = k * 2.39996323f;
+      x[k] = 0.1f + 1e-3f * sinPolar * cosf(azimuth);
+      y[k] = 1e-3f * sinPolar * sinf(azimuth);
+      z[k] = 1e-3f * cosPolar;
+
+      // Hue by trajectory, so neighbours separate into distinct colors
+      float hue = 6.2831853f * k / trajectories;
+      color[3 * k] = 0.5f + 0.5f * cosf(hue);
+      color[3 * k + 1] = 0.5f + 0.5f * cosf(hue - 2.0944f);
+      color[3 * k + 2] = 0.5f + 0.5f * cosf(hue + 2.0944f);
+    }
+
+    workers.parallelFor(trajectories / FloatLanes::width, [&](int beginGroup, int endGroup) {
+      const int begin = beginGroup * FloatLanes::width, lanes = (endGroup - beginGroup) * FloatLanes::width;
+      float *const soa[3] = {x + begin, y + begin, z + begin};
+      for (int point = 0; point < lorenzEnsembleLength; ++point) {
+        const float fade = 0.35f + 0.65f * point / lorenzEnsembleLength;
+        for (int k = begin; k < begin + lanes; ++k) {
+          emitVertex(out + ((size_t)k * lorenzEnsembleLength + point) * 6, x[k] * 0.1f, y[k] * 0.1f - 0.5f, z[k] * 0.1f - 0.5f, fade * color[3 * k],
+                     fade * color[3 * k + 1], fade * color[3 * k + 2]);
+        }
+        rk4Batch(field, soa, lanes, dt, lorenzEnsembleSubsteps);
+      }
+    });
+    return (size_t)trajectories * lorenzEnsembleLength;
+  }
+
+  static size_t countKleinBottle(int) { return FinestTessellation::segments(100) * FinestTessellation::segments(50); }
+
+  template <typename Tessellation>
+  size_t generateKleinBottle(float *out, float t) {
+    constexpr int uSeg = Tessellation::segments(100), vSeg = Tessellation::segments(50);
+    const TrigTable<uSeg> &uTable = trigTable<uSeg>;
+    const TrigTable<2 * uSeg> &halfTable = trigTable<2 * uSeg>;  // u / 2
+    const TrigTable<vSeg> &vTable = trigTable<vSeg>;
+    float r = 1.5f + 0.3f * sin(t);
+    const float cos07T = cosf(0.7f * t), sin07T = sinf(0.7f * t);
+
+    for (int iu = 0; iu < uSeg; ++iu) {
+      const float cosU = uTable.cos[iu], sinU = uTable.sin[iu];
+      const float cosHalf = halfTable.cos[iu], sinHalf = halfTable.sin[iu];
+      const float cosW = cosU * cos07T - sinU * sin07T;  // u + 0.7t
+      const float sinW = sinU * cos07T + cosU * sin07T;
+
+      for (int iv = 0; iv < vSeg; ++iv) {
+        const float cosV = vTable.cos[iv], sinV = vTable.sin[iv];
+        const float sin2V = vTable.sin[(2 * iv) % vSeg];
+        const float radial = r + cosHalf * sinV - sinHalf * sin2V;
+        float x = radial * cosU;
+        float y = radial * sinU;
+        float z = sinHalf * sinV + cosHalf * sin2V;
+
+        // Colormap coordinate follows sin(u + v + 0.7t)
+        out = emitScalarVertex(out, x * 0.3f, y * 0.3f, z * 0.3f, 0.5f + 0.5f * (sinW * cosV + cosW * sinV));
+      }
+    }
+    return uSeg * vSeg;
+  }
+
+  static const GenerateFn kleinBottleKernels[];
+  static const SurfaceLod kleinBottleLod;
+
+  static int gyroidGridSize(int qualityMult) {
+    const int base = 50;
+    const int qm = qualityMult;  // 1,2,4,8
+    const int grid = base * qm;             // 50,100,200,400
+    // then maybe cap it
+    const int maxGrid = 120;
+    return std::min(grid, maxGrid);
+  }
+
+  // Upper bound: every lattice point could lie inside the level-set band
+  static size_t countGyroid(int qualityMult) {
+    size_t grid = gyroidGridSize(qualityMult);
+    return grid * grid * grid;
+  }
+
+  size_t generateGyroid(float *out, float t) {
+    const int finalGrid = gyroidGridSize(getQualityMultiplier());
+    float level = sin(t * 0.6f) * 0.5f;
+    size_t written = 0;
+
+    // The field is separable per axis: sin and cos of each grid coordinate are
+    // computed once, and the kernel evaluates whole z rows from them
+    float *coords = frameArena.alloc<float>(finalGrid);
+    float *sines = frameArena.alloc<float>(finalGrid);
+    float *cosines = frameArena.alloc<float>(finalGrid);
+    float *values = frameArena.alloc<float>(finalGrid);
+    for (int i = 0; i < finalGrid; ++i) coords[i] = (i / (float)finalGrid - 0.5f) * 4.0f;
+    SimdKernels::active->sinCos(coords, finalGrid, sines, cosines);
+
+    for (int i = 0; i < finalGrid; ++i) {
+      for (int j = 0; j < finalGrid; ++j) {
+        SimdKernels::active->gyroidRow(sines[i] * cosines[j], sines[j], cosines[i], sines, cosines, finalGrid, values);
+        for (int k = 0; k < finalGrid; ++k) {
+          float v = values[k];
+          if (fabs(v - level) < 0.05f) {
+            // Colormap coordinate is the position across the level-set band
+            out = emitScalarVertex(out, coords[i], coords[j], coords[k], (v - level + 0.05f) / 0.1f);
+            ++written;
+          }
+        }
+      }
+    }
+    return written;
+  }
+
+  static size_t countSphericalHarmonic(int) { return (FinestTessellation::segments(40) + 1) * (FinestTessellation::segments(80) + 1); }
+
+  // sph_legendre(l, m, cos theta) is sin(l theta + m / 2), so the l theta and
+  // m phi multiples index the same tables as theta and phi
+  template <typename Tessellation>
+  size_t generateSphericalHarmonic(float *out, float t) {
+    constexpr int latSeg = Tessellation::segments(40), lonSeg = Tessellation::segments(80);
+    const TrigTable<2 * latSeg> &latTable = trigTable<2 * latSeg>;  // theta = pi i / latSeg
+    const TrigTable<lonSeg> &lonTable = trigTable<lonSeg>;
+    int ℓ = 2 + (int)(2.0f * fabs(sin(t * 0.3f)));
+    int m = ℓ / 2;
+    float eps = 0.2f + 0.3f * fabs(cos(t * 0.4f));
+    const float cosHalfM = cosf(m * 0.5f), sinHalfM = sinf(m * 0.5f);
+
+    for (int i = 0; i <= latSeg; ++i) {
+      const float sinθ = latTable.sin[i], cosθ = latTable.cos[i];
+      const int lθ = (ℓ * i) % (2 * latSeg);
+      const float legendre = latTable.sin[lθ] * cosHalfM + latTable.cos[lθ] * sinHalfM;
+      for (int j = 0; j <= lonSeg; ++j) {
+        const float cosφ = lonTable.cos[j], sinφ = lonTable.sin[j];
+        float Y = legendre * lonTable.cos[(m * j) % lonSeg];
+        float R = 1.0f + eps * Y;
+        float x = R * sinθ * cosφ;
+        float y = R * sinθ * sinφ;
+        float z = R * cosθ;
+
+        out = emitScalarVertex(out, x, y, z, 0.5f + 0.5f * Y);
+      }
+    }
+    return (latSeg + 1) * (lonSeg + 1);
+  }
+
+  static const GenerateFn sphericalHarmonicKernels[];
+  static const SurfaceLod sphericalHarmonicLod;
+
+  static int fractalResolution(int qualityMult) { return 200 * sqrt(qualityMult); }
+
+  static size_t countFractalZoom(int qualityMult) { return fractalResolution(qualityMult) * fractalResolution(qualityMult); }
+
+  // Animated view shared by the CPU and GPU fractal renderers
+  struct FractalView {
+    float zoom;    // Width of the view in the complex plane
+    float cx, cy;  // Center
+  };
+
+  static FractalView fractalView(float t) { return {1.5f + 0.5f * sinf(t * 0.2f), -0.5f + 0.2f * cosf(t * 0.3f), 0.2f * sinf(t * 0.4f)}; }
+
+  // Writes one normalized escape height per cell, row-major over (i, j); the
+  // vertex shader places cell (i, j) at (i / res - 0.5, h - 0.5, j / res - 0.5)
+  size_t generateFractalZoom(float *heights, float t) {
+    const int res = fractalResolution(getQualityMultiplier());
+
+    const FractalView view = fractalView(t);
+    const int maxI = 100;
+
+    // Rows share their imaginary parts; the kernel iterates a row in lane blocks
+    float *ci = frameArena.alloc<float>(res);
+    for (int j = 0; j < res; ++j) ci[j] = (j / (float)res - 0.5f) * view.zoom + view.cy;
+
+    for (int i = 0; i < res; ++i) {
+      float x0 = (i / (float)res - 0.5f) * view.zoom + view.cx;
+      SimdKernels::active->mandelbrotRow(x0, ci, res, maxI, heights + (size_t)i * res);
+    }
+    return res * res;
+  }
+
+  // Deep zoom toward a Misiurewicz point, cycling between a scale of 3 and
+  // 3e-30. Each pixel iterates its offset from the shared reference orbit:
+  //   d_{n+1} = (2 Z_n + d_n) d_n + dc
+  // in double precision, which keeps offsets far below float's range accurate.
+  // When the full value z = Z + d comes closer to zero than d itself, d has lost
+  // the precision it needs (a glitch); the pixel is then rebased onto the start of
+  // the reference orbit with d = z. The same rebase handles running past the end
+  // of an escaped reference orbit.
+  size_t generateDeepZoom(float *heights, float t) {
+    const int res = fractalResolution(getQualityMultiplier());
+
+    // Misiurewicz point M(5,1) = -0.63675434658238997870721256213 + 0.68503129708367730130503803202i.
+    // Its orbit lands on a repelling fixed point, so the view stays equally detailed at
+    // every depth and escape counts grow only linearly with it
+    const DoubleDouble centerRe = {-0.6367543465823899, -3.8028631265025543e-17};
+    const DoubleDouble centerIm = {0.6850312970836773, 3.0506719372803874e-17};
+    if (deepZoomOrbit.re.empty() || deepZoomOrbit.cr.hi != centerRe.hi || deepZoomOrbit.ci.hi != centerIm.hi) {
+      deepZoomOrbit.reset(centerRe, centerIm);
+      deepZoomOrbit.re.reserve(deepZoomIterations(30.0) + 1);
+      deepZoomOrbit.im.reserve(deepZoomIterations(30.0) + 1);
+    }
+
+    // Decimal digits of zoom
+    const double depth = 15.0 * (1.0 - cos(t * 0.08));
+    const double scale = 3.0 * pow(10.0, -depth);
+    const int maxI = deepZoomIterations(depth);
+    deepZoomOrbit.extend(maxI);
+    const double *orbitRe = deepZoomOrbit.re.data();
+    const double *orbitIm = deepZoomOrbit.im.data();
+    const int orbitLast = (int)deepZoomOrbit.re.size() - 1;
+
+    int *iterations = frameArena.alloc<int>((size_t)res * res);
+    int minEscape = maxI, maxEscape = 0;
+    for (int i = 0; i < res; ++i) {
+      for (int j = 0; j < res; ++j) {
+        const double dcr = (i / (double)res - 0.5) * scale;
+        const double dci = (j / (double)res - 0.5) * scale;
+        double dr = 0.0, di = 0.0;
+        int m = 0, iter = 0;
+
+        while (iter < maxI) {
+          double zr = orbitRe[m], zi = orbitIm[m];
+          double ndr = 2.0 * (zr * dr - zi * di) + (dr * dr - di * di) + dcr;
+          double ndi = 2.0 * (zr * di + zi * dr) + 2.0 * dr * di + dci;
+          dr = ndr;
+          di = ndi;
+          ++m;
+          ++iter;
+
+          double fr = orbitRe[m] + dr, fi = orbitIm[m] + di;
+          double magnitude = fr * fr + fi * fi;
+          if (magnitude > 4.0) break;
+          if (magnitude < dr * dr + di * di || m == orbitLast) {
+            dr = fr;
+            di = fi;
+            m = 0;
+          }
+        }
+
+        iterations[i * res + j] = iter;
+        if (iter < maxI) {
+          minEscape = std::min(minEscape, iter);
+          maxEscape = std::max(maxEscape, iter);
+        }
+      }
+    }
+
+    // Deep views have a large shared iteration floor, so heights span the escape
+    // counts actually present; points inside the set sit at the top
+    const float range = (float)std::max(1, maxEscape - minEscape);
+    for (int cell = 0; cell < res * res; ++cell) {
+      *heights++ = iterations[cell] >= maxI ? 1.0f : sqrtf((iterations[cell] - minEscape) / range);
+    }
+    return res * res;
+  }
+
+  static size_t countPhyllotaxis(int qualityMult) { return 1000 * qualityMult; }
+
+  size_t generatePhyllotaxis(float *out, float t) {
+    const int seeds = countPhyllotaxis(getQualityMultiplier());
+    float angle0 = (1.6180339887f + 0.1f * sin(t * 0.5f)) * M_PI;
+
+    for (int n = 0; n < seeds; ++n) {
+      float θ = n * angle0;
+      float r = 0.02f * sqrtf(n);
+      float x = r * cos(θ);
+      float y = r * sin(θ);
+
+      out = emitPlanarVertex(out, x, y, 0.5f + 0.5f * sin(θ + t), 0.5f + 0.5f * cos(θ + t * 1.2f), 0.5f + 0.5f * sin(t));
+    }
+    return seeds;
+  }
+
+  static size_t countTesseract4D(int) { return 16; }
+
+  size_t generateTesseract4D(float *out, float t) {
+    // Scratch corners come from the frame arena instead of a per-frame vector
+    std::array<float, 4> *pts4 = frameArena.alloc<std::array<float, 4>>(16);
+    for (int i = 0; i < 16; i++) {
+      for (int d = 0; d < 4; d++) pts4[i][d] = (i & (1 << d)) ? 1.0f : -1.0f;
+    }
+
+    float c = cos(t * 0.3f), s = sin(t * 0.3f);
+    for (int i = 0; i < 16; i++) {
+      std::array<float, 4> &v = pts4[i];
+      float x = v[0], w = v[3];
+      v[0] = c * x - s * w;
+      v[3] = s * x + c * w;
+    }
+
+    float dist = 3.0f + sin(t * 0.5f);
+    for (int i = 0; i < 16; i++) {
+      const std::array<float, 4> &v = pts4[i];
+      float w = 1.0f / (dist - v[3]);
+      float x = v[0] * w, y = v[1] * w, z = v[2] * w;
+
+      out = emitVertex(out, x, y, z, 0.5f + 0.5f * (v[3]), 1.0f - 0.5f * (v[3]), 0.5f + 0.5f * sin(t));
+    }
+    return 16;
+  }
+
+  static int waveInterferenceGridSize(int qualityMult) { return 100 * sqrt(qualityMult); }
+
+  static size_t countWaveInterference(int qualityMult) { return waveInterferenceGridSize(qualityMult) * waveInterferenceGridSize(qualityMult); }
+
+  size_t buildWaveInterferenceGrid(float *out, float) {
+    const int grid = waveInterferenceGridSize(getQualityMultiplier());
+    const float size = 4.0f;
+    waveInterferenceMesh.heightBound = 1.0f;  // Two waves of amplitude 0.5 in wave_interference.vert
+
+    for (int i = 0; i < grid; i++) {
+      for (int j = 0; j < grid; j++) {
+        out[0] = (i / (float)grid - 0.5f) * size;
+        out[1] = (j / (float)grid - 0.5f) * size;
+        out[2] = 0.0f;
+        out += 3;
+      }
+    }
+    return grid * grid;
+  }
+
+  // Surface mesh plus gridLines lines in each direction, every third sample
+  static size_t countGravitationalSpacetime(int) { return 80 * 80 + 15 * 2 * ((80 + 2) / 3); }
+
+  // The aux component marks overlaid grid-line vertices (1) versus surface (0)
+  size_t buildGravitationalSpacetimeGrid(float *out, float) {
+        float *start = out;
+
+        const int gridSize = 80;
+        const float extent = 4.0f;
+        const int gridLines = 15;
+
+        // Surface mesh
+        for (int i = 0; i < gridSize; ++i) {
+            float x = (float(i) / (gridSize - 1)) * 2.0f * extent - extent;
+            for (int j = 0; j < gridSize; ++j) {
+                float z = (float(j) / (gridSize - 1)) * 2.0f * extent - extent;
+                out[0] = x;
+                out[1] = z;
+                out[2] = 0.0f;
+                out += 3;
+            }
+        }
+
+        // Grid lines overlaid on surface
+        for (int line = 0; line < gridLines; ++line) {
+            float coord = (float(line) / (gridLines - 1)) * 2.0f * extent - extent;
+
+            // Vertical grid lines
+            for (int j = 0; j < gridSize; j += 3) {
+                out[0] = coord;
+                out[1] = (float(j) / (gridSize - 1)) * 2.0f * extent - extent;
+                out[2] = 1.0f;
+                out += 3;
+            }
+
+            // Horizontal grid lines
+            for (int i = 0; i < gridSize; i += 3) {
+                out[0] = (float(i) / (gridSize - 1)) * 2.0f * extent - extent;
+                out[1] = coord;
+                out[2] = 1.0f;
+                out += 3;
+            }
+        }
+        return (out - start) / 3;
+    }
+
+
+
+  //   void generateGravitationalSpacetime(std::vector<float> &vertices, float t) {
+  //     vertices.clear();
+  //     const int gridSize = 100 * sqrt(getQualityMultiplier());
+  //     const float extent = 4.0f;
+
+  //     // Central mass position (can be animated)
+  //     float massX = 0.5f * sin(t * 0.3f);
+  //     float massZ = 0.5f * cos(t * 0.3f);
+
+  //     // Generate spacetime grid surface
+  //     for (int i = 0; i < gridSize; ++i) {
+  //       for (int j = 0; j < gridSize; ++j) {
+  //         float x = (float)i / (gridSize - 1) * extent - extent / 2.0f;
+  //         float z = (float)j / (gridSize - 1) * extent - extent / 2.0f;
+
+  //         // Distance from the central mass
+  //         float dx = x - massX;
+  //         float dz = z - massZ;
+  //         float r = sqrt(dx * dx + dz * dz);
+
+  //         // Gravitational potential with adjustable mass
+  //         // φ = -GM/r, but we'll use a modified version to prevent singularity
+  //         float minRadius = 0.1f;  // Prevent division by zero
+  //         float effectiveRadius = std::max(r, minRadius);
+
+  //         // Spacetime curvature: y displacement proportional to gravitational potential
+  //         float gravitationalPotential = -centralMass / effectiveRadius;
+
+  //         // Apply curvature with smooth falloff
+  //         float curvature = gravitationalPotential * maxDeformation;
+
+  //         // Add some time-based oscillation to show dynamic effects
+  //         float timeEffect = 0.1f * sin(t * 2.0f + r * 3.0f) * centralMass;
+
+  //         float y = curvature + timeEffect;
+
+  //         vertices.push_back(x);
+  //         vertices.push_back(y);
+  //         vertices.push_back(z);
+
+  //         // Color based on curvature depth and mass
+  //         float depth = -y / maxDeformation;  // Normalize depth
+  //         float redIntensity = std::min(1.0f, std::max(0.0f, depth * 0.8f + 0.2f));
+  //         float greenIntensity = std::min(1.0f, std::max(0.1f, 1.0f - depth * 0.5f));
+  //         float blueIntensity = std::min(1.0f, std::max(0.1f, 0.3f + depth * 0.4f));
+
+  //         // Add mass-dependent coloring
+  //         float massInfluence = centralMass / 5.0f;  // Normalize to 0-1
+  //         redIntensity = std::min(1.0f, redIntensity + massInfluence * 0.3f);
+
+  //         vertices.push_back(redIntensity);
+  //         vertices.push_back(greenIntensity);
+  //         vertices.push_back(blueIntensity);
+  //       }
+  //     }
+
+  //     // Add the central mass as a bright sphere
+  //     const int spherePoints = 50;
+  //     for (int i = 0; i < spherePoints; ++i) {
+  //       float theta = 2.0f * M_PI * i / spherePoints;
+  //       float radius = 0.05f + 0.02f * centralMass;  // Size based on mass
+
+  //       float x = massX + radius * cos(theta);
+  //       float z = massZ + radius * sin(theta);
+  //       float y = -0.1f;  // Slightly above the surface
+
+  //       vertices.push_back(x);
+  //       vertices.push_back(y);
+  //       vertices.push_back(z);
+
+  //       // Bright white/yellow for the mass
+  //       vertices.push_back(1.0f);
+  //       vertices.push_back(1.0f - 0.2f * sin(t * 3.0f));
+  //       vertices.push_back(0.3f);
+  //     }
+
+  //     // Add grid lines to better show the curvature
+  //     const int gridLines = 20;
+  //     for (int line = 0; line < gridLines; ++line) {
+  //       // Vertical lines
+  //       float x = (float)line / (gridLines - 1) * extent - extent / 2.0f;
+  //       for (int j = 0; j < gridSize; j += 2) {
+  //         float z = (float)j / (gridSize - 1) * extent - extent / 2.0f;
+
+  //         float dx = x - massX;
+  //         float dz = z - massZ;
+  //         float r = sqrt(dx * dx + dz * dz);
+  //         float effectiveRadius = std::max(r, 0.1f);
+  //         float y = -centralMass / effectiveRadius * maxDeformation;
+
+  //         vertices.push_back(x);
+  //         vertices.push_back(y + 0.01f);  // Slightly above surface
+  //         vertices.push_back(z);
+
+  //         vertices.push_back(0.8f);
+  //         vertices.push_back(0.8f);
+  //         vertices.push_back(0.9f);
+  //       }
+
+  //       // Horizontal lines
+  //       float z = (float)line / (gridLines - 1) * extent - extent / 2.0f;
+  //       for (int i = 0; i < gridSize; i += 2) {
+  //         float x = (float)i / (gridSize - 1) * extent - extent / 2.0f;
+
+  //         float dx = x - massX;
+  //         float dz = z - massZ;
+  //         float r = sqrt(dx * dx + dz * dz);
+  //         float effectiveRadius = std::max(r, 0.1f);
+  //         float y = -centralMass / effectiveRadius * maxDeformation;
+
+  //         vertices.push_back(x);
+  //         vertices.push_back(y + 0.01f);  // Slightly above surface
+  //         vertices.push_back(z);
+
+  //         vertices.push_back(0.8f);
+  //         vertices.push_back(0.8f);
+  //         vertices.push_back(0.9f);
+  //       }
+  //     }
+  //   }
 
-    if (keys[GLFW_KEY_W]) cameraPos += cameraFront * velocity;
-    if (keys[GLFW_KEY_S]) cameraPos -= cameraFront * velocity;
-    if (keys[GLFW_KEY_A]) cameraPos -= cameraRight * velocity;
-    if (keys[GLFW_KEY_D]) cameraPos += cameraRight * velocity;
-    if (keys[GLFW_KEY_SPACE]) cameraPos += cameraUp * velocity;
-    if (keys[GLFW_KEY_LEFT_SHIFT] || keys[GLFW_KEY_C]) cameraPos -= cameraUp * velocity;
+  void selectMode(int mode) {
+    waitForGeneration();
+    animationMode = mode;
+    ensureProgramsFor(generators[mode]);
+    presizeForMode();
   }
 
-  void updateBackgroundColor() {
-    const Color &bg = backgrounds[backgroundMode];
-    glClearColor(bg.r, bg.g, bg.b, 1.0f);
+  // Plugin directory, overridable with MANIM_PLUGIN_DIR
+  static const char *pluginDirectory() {
+    const char *dir = getenv("MANIM_PLUGIN_DIR");
+    return dir ? dir : "plugins";
   }
 
-  void setTargetFPS(int fps) {
-    targetFPS = fps;
-    frameTime = 1.0f / fps;
+  // Scans the plugin directory on a background thread; pollPlugins() adds the
+  // modes once the scan has finished
+  void startPluginLoader() {
+    pluginLoader = std::thread([this] {
+      auto start = std::chrono::steady_clock::now();
+      pluginHost.loadDirectory(pluginDirectory());
+      pluginLoadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      pluginsLoaded.store(true, std::memory_order_release);
+    });
+  }
 
-    // Update VSync based on FPS
-    if (fps == 60) {
-      glfwSwapInterval(1);  // VSync on for 60 FPS
-    } else {
-      glfwSwapInterval(0);  // VSync off for custom FPS
+  // Rebuilds the registry entries that follow the built-in modes from the loaded
+  // plugins. Entries point into plugin memory, so this runs after every reload.
+  void syncPluginModes() {
+    generators.resize(builtinGeneratorCount);
+    for (size_t i = 0; i < pluginHost.count(); ++i) {
+      const PluginHost::Plugin &plugin = pluginHost[i];
+      GeneratorInfo info = {};
+      info.name = plugin.name.c_str();
+      info.key = GLFW_KEY_UNKNOWN;  // Selected with N
+      info.keyLabel = "N";
+      info.path = DrawPath::CpuVertices;
+      info.primitive = plugin.api->primitive == MANIM_PRIMITIVE_POINTS ? GL_POINTS : GL_LINE_STRIP;
+      info.timeDependent = plugin.api->timeDependent != 0;
+      info.stableTopology = false;  // Not part of the plugin ABI
+      info.cost = CostClass::Light;
+      info.maxVertices = plugin.api->maxVertices;
+      info.generate = &MathAnimation::generatePluginVertices;
+      info.pointExtent = 2.0f;
+      info.pointDimensions = 3;
+      generators.push_back(info);
     }
+    if (modeMemory.size() < generators.size()) modeMemory.resize(generators.size());
+  }
 
-    std::cout << "Target FPS set to: " << fps << "\n";
+  // Picks up rebuilt plugins; the active mode and camera are kept
+  void pollPlugins() {
+    if (pluginLoader.joinable()) {
+      if (!pluginsLoaded.load(std::memory_order_acquire)) return;
+      pluginLoader.join();
+      syncPluginModes();
+      std::cout << "Plugins: " << pluginHost.count() << " loaded in " << std::fixed << std::setprecision(1) << pluginLoadMs
+                << " ms (background)" << std::defaultfloat << "\n";
+      return;
+    }
+    if (!pluginsLoaded.load(std::memory_order_relaxed)) return;
+    if (!pluginHost.detectChanges()) return;
+    // A reload unloads the old library, which a plugin mode's job may be running
+    if (animationMode >= builtinGeneratorCount) waitForGeneration();
+    if (!pluginHost.applyChanges()) return;
+    syncPluginModes();
+    if (animationMode >= builtinGeneratorCount) presizeForMode();
   }
 
-  void setQuality(int quality) {
-    qualityLevel = quality;
-    const char *qualityNames[] = {"Low", "Medium", "High", "Ultra"};
-    std::cout << "Quality set to: " << qualityNames[quality] << "\n";
+  void cyclePluginMode() {
+    if (generators.size() == (size_t)builtinGeneratorCount) {
+      std::cout << (pluginsLoaded ? "No plugins loaded from " : "Plugins are still loading from ") << pluginDirectory() << "\n";
+      return;
+    }
+    int next = animationMode + 1;
+    if (next < builtinGeneratorCount || next >= (int)generators.size()) next = builtinGeneratorCount;
+    selectMode(next);
+    std::cout << "Plugin: " << generators[next].name << "\n";
   }
 
-  void toggleVSync() {
-    static bool vsyncEnabled = true;
-    vsyncEnabled = !vsyncEnabled;
-    glfwSwapInterval(vsyncEnabled ? 1 : 0);
-    std::cout << "VSync " << (vsyncEnabled ? "enabled" : "disabled") << "\n";
+  size_t generatePluginVertices(float *out, float t) {
+    const ManimGeneratorPlugin *api = pluginHost[animationMode - builtinGeneratorCount].api;
+    int qualityMult = getQualityMultiplier();
+    size_t capacity = api->maxVertices(qualityMult);
+    return std::min(api->generate(out, capacity, t, qualityMult), capacity);
   }
 
-  int getQualityMultiplier() {
-    switch (qualityLevel) {
-      case 0:
-        return 1;  // Low: 1x
-      case 1:
-        return 2;  // Medium: 2x
-      case 2:
-        return 4;  // High: 4x
-      case 3:
-        return 8;  // Ultra: 8x
-      default:
-        return 4;
+  // Sizes CPU staging and GPU storage for the selected mode at the current quality
+  // level from its registry entry, so frames spent in the mode never allocate
+  void presizeForMode() {
+    waitForGeneration();
+    const GeneratorInfo &generator = generators[animationMode];
+    size_t maxVertices = generator.maxVertices(getQualityMultiplier());
+
+    switch (generator.path) {
+      case DrawPath::CpuVertices:
+      case DrawPath::CpuPlanar:
+      case DrawPath::CpuScalar: {
+        size_t floats = maxVertices * vertexFloats(generator);
+        if (vertices.size() < floats) vertices.resize(floats);
+        for (GLuint buffer : {VBO, keyframeVBO}) {
+          if (buffer == keyframeVBO && !keyframed(generator)) continue;
+          if (floats * sizeof(float) > gpuBuffers.size(buffer)) {
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            gpuBuffers.allocate(GL_ARRAY_BUFFER, buffer, floats * sizeof(float), NULL, GL_DYNAMIC_DRAW);
+          }
+        }
+        break;
+      }
+      case DrawPath::GpuHeightfield:
+        ensureHeightfieldMesh(generator);
+        break;
+      case DrawPath::HeightStream: {
+        if (heightCells.size() < maxVertices) heightCells.resize(maxVertices);
+        // Both streamed modes are square grids over the unit square
+        HeightStream &stream = this->*generator.stream;
+        stream.resolution = (int)std::lround(std::sqrt((double)maxVertices));
+        stream.origin[0] = stream.origin[1] = -0.5f;
+        stream.spacing[0] = stream.spacing[1] = 1.0f / stream.resolution;
+        stream.heightOffset = -0.5f;
+        break;
+      }
+      case DrawPath::GpuParticles:
+        ensureParticleSystem();
+        break;
+      case DrawPath::GpuFractal:
+        if (fractalTerrain) ensureFractalHeightMap();
+        break;
     }
+    generationDirty = true;
   }
 
-  // Placeholder for missing math functions
-  float sph_legendre(int l, int m, float x) {
-    // Simplified spherical harmonic - just use sine/cosine approximation
-    return sin(l * acos(x) + m * 0.5f);
+  // Lets the generator write in place into storage presized from its registry
+  // entry. Storage only grows, so the check below only fires if presizing was
+  // skipped.
+  size_t generateInto(const GeneratorInfo &generator, float t, int level) {
+    size_t required = generator.maxVertices(getQualityMultiplier()) * vertexFloats(generator);
+    if (vertices.size() < required) vertices.resize(required);
+    return (this->*generatorFor(generator, level))(vertices.data(), t);
   }
 
-  void generateParametricSpiral(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int numPoints = 1000 * getQualityMultiplier();
-
-    for (int i = 0; i < numPoints; ++i) {
-      float param = (float)i / numPoints * 10.0f * M_PI;
-      float radius = 0.8f + 0.4f * sin(param * 0.1f + t);
-
-      float x = radius * cos(param + t);
-      float y = sin(param * 0.3f + t * 0.5f) * 0.5f;
-      float z = radius * sin(param + t);
-
-      vertices.push_back(x);
-      vertices.push_back(y);
-      vertices.push_back(z);
-
-      float r = 0.6f + 0.4f * sin(param * 0.2f + t);
-      float g = 0.6f + 0.4f * cos(param * 0.15f + t * 1.5f);
-      float b = 0.6f + 0.4f * sin(param * 0.3f + t * 0.8f);
-
-      vertices.push_back(r);
-      vertices.push_back(g);
-      vertices.push_back(b);
+  // Copies `count` generated vertices into `buffer` and returns the bytes uploaded.
+  // GPU storage is only reallocated when it has to grow; otherwise it is orphaned
+  // at its current size and refilled.
+  size_t uploadVertices(const GeneratorInfo &generator, GLuint buffer, size_t count) {
+    size_t bytes = count * vertexFloats(generator) * sizeof(float);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (bytes > gpuBuffers.size(buffer)) {
+      gpuBuffers.allocate(GL_ARRAY_BUFFER, buffer, bytes, vertices.data(), GL_DYNAMIC_DRAW);
+    } else {
+      gpuBuffers.allocate(GL_ARRAY_BUFFER, buffer, gpuBuffers.size(buffer), NULL, GL_DYNAMIC_DRAW);
+      glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices.data());
     }
+    return bytes;
   }
 
-  void generateLissajous(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int numPoints = 2000 * getQualityMultiplier();
-
-    for (int i = 0; i < numPoints; ++i) {
-      float param = (float)i / numPoints * 4.0f * M_PI;
-
-      float x = 1.2f * sin(3.0f * param + t);
-      float y = 1.0f * sin(2.0f * param + t * 0.7f);
-      float z = 0.8f * sin(5.0f * param + t * 1.3f);
-
-      vertices.push_back(x);
-      vertices.push_back(y);
-      vertices.push_back(z);
+  // The orthographic toggle only applies to planar modes, as in the draw
+  void latchGenerationView(const GeneratorInfo &generator) {
+    generationJob.eye = cameraPos;
+    generationJob.viewportHeight = windowHeight;
+    generationJob.ortho = planarOrtho && generator.path == DrawPath::CpuPlanar;
+  }
 
-      float r = 0.7f + 0.3f * sin(param + t);
-      float g = 0.7f + 0.3f * sin(param + t + 2.0f * M_PI / 3.0f);
-      float b = 0.7f + 0.3f * sin(param + t + 4.0f * M_PI / 3.0f);
+  // Starts generating `generator` at time t on the generation thread. Surfaces pick
+  // their tessellation unless `level` is given.
+  void startGeneration(const GeneratorInfo &generator, float t, long long keyframe = -1, int level = -1) {
+    GenerationJob &job = generationJob;
+    job.generator = generator;
+    job.t = t;
+    job.keyframe = keyframe;
+    job.tessellationLevel = level;
+    latchGenerationView(generator);
+    generationPending = true;
+    generationThread.submit([](void *app) { static_cast<MathAnimation *>(app)->runGenerationJob(); }, this);
+  }
 
-      vertices.push_back(r);
-      vertices.push_back(g);
-      vertices.push_back(b);
+  // Runs on the generation thread
+  void runGenerationJob() {
+    GenerationJob &job = generationJob;
+    auto start = std::chrono::steady_clock::now();
+    frameArena.reset();
+    if (job.generator.path == DrawPath::HeightStream) {
+      job.count = (this->*job.generator.generate)(heightCells.data(), job.t);
+    } else {
+      if (job.tessellationLevel < 0) job.tessellationLevel = job.generator.lod ? selectTessellation(*job.generator.lod) : 0;
+      job.count = generateInto(job.generator, job.t, job.tessellationLevel);
     }
+    job.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
   }
 
-  void generate3DHelix(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int numPoints = 1500 * getQualityMultiplier();
-
-    for (int i = 0; i < numPoints; ++i) {
-      float param = (float)i / numPoints * 12.0f * M_PI;
-      float amplitude = 1.0f + 0.3f * sin(t * 2.0f);
-
-      float x = amplitude * cos(param + t);
-      float y = (param / (6.0f * M_PI) - 1.0f) * 1.5f;
-      float z = amplitude * sin(param + t);
-
-      vertices.push_back(x);
-      vertices.push_back(y);
-      vertices.push_back(z);
+  // Blocks until the job in flight, if any, is done; its result is still taken as usual
+  void waitForGeneration() {
+    if (generationPending) generationThread.wait();
+  }
 
-      float intensity = (float)i / numPoints;
-      vertices.push_back(0.8f * intensity + 0.2f);
-      vertices.push_back(0.8f * (1.0f - intensity) + 0.2f);
-      vertices.push_back(0.7f + 0.3f * sin(t + param));
+  // Takes the result of the job in flight once it is done, waiting for it if
+  // `block`; false if there is no finished job
+  bool takeGeneration(bool block) {
+    if (!generationPending) return false;
+    if (block) {
+      generationThread.wait();
+    } else if (!generationThread.idle()) {
+      return false;
     }
+    generationPending = false;
+    return true;
   }
 
-  void generateSineWaveSurface(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int gridSize = 80 * sqrt(getQualityMultiplier());
-    const float scale = 3.0f;
-
-    for (int i = 0; i < gridSize; ++i) {
-      for (int j = 0; j < gridSize; ++j) {
-        float x = (float)i / gridSize * scale - scale / 2;
-        float z = (float)j / gridSize * scale - scale / 2;
-
-        float distance = sqrt(x * x + z * z);
-        float y = 0.6f * sin(distance * 2.5f - t * 3.0f) * exp(-distance * 0.4f);
-
-        vertices.push_back(x);
-        vertices.push_back(y);
-        vertices.push_back(z);
-
-        float heightIntensity = (y + 0.6f) * 0.8f + 0.2f;
-        float r = 0.3f + 0.7f * heightIntensity;
-        float g = 0.2f + 0.6f * sin(distance * 0.5f + t);
-        float b = 0.8f + 0.2f * cos(distance * 0.3f + t * 1.2f);
+  // Discards the job in flight and generates on the spot, for frames that have
+  // nothing current to draw
+  const GenerationJob &generateNow(const GeneratorInfo &generator, float t, long long keyframe = -1, int level = -1) {
+    takeGeneration(true);
+    startGeneration(generator, t, keyframe, level);
+    takeGeneration(true);
+    return generationJob;
+  }
 
-        vertices.push_back(r);
-        vertices.push_back(g);
-        vertices.push_back(b);
-      }
+  // True when the staging storage holds a new result for this frame to upload:
+  // the finished job, or after a change of mode or settings, a fresh one
+  bool takeGenerationResult(const GeneratorInfo &generator, float t, double &generateMs) {
+    bool taken;
+    if (generationDirty) {
+      generateNow(generator, t);
+      generationDirty = false;
+      taken = true;
+    } else {
+      taken = takeGeneration(false);
     }
+    if (taken) generateMs += generationJob.ms;
+    return taken;
   }
 
-  void generateTorus(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int qualityMult = getQualityMultiplier();
-    const int majorSegments = 60 * qualityMult;
-    const int minorSegments = 40 * qualityMult;
-    const float majorRadius = 1.2f;
-    const float minorRadius = 0.4f + 0.2f * sin(t * 2.0f);
+  // Starts the next job once the last result is uploaded, for the time it is
+  // expected on screen
+  void keepGenerating(const GeneratorInfo &generator, float t) {
+    if (generator.timeDependent && !generationPending) startGeneration(generator, t + deltaTime);
+  }
 
-    for (int i = 0; i < majorSegments; ++i) {
-      for (int j = 0; j < minorSegments; ++j) {
-        float u = 2.0f * M_PI * i / majorSegments + t;
-        float v = 2.0f * M_PI * j / minorSegments;
+  // Whether the mode is blended from keyframes rather than generated every frame
+  bool keyframed(const GeneratorInfo &generator) const { return keyframesEnabled && generator.stableTopology && generator.timeDependent; }
+
+  // Keeps keyframes floor(t * rate) and the one after it in the two buffers and
+  // sets the blend weight for t. The keyframe after the pair is generated in the
+  // background while the pair is on screen, and uploaded into the older slot when
+  // t crosses into the next interval.
+  void advanceKeyframes(const GeneratorInfo &generator, float t, double &generateMs, size_t &uploadBytes) {
+    KeyframePair &pair = keyframes;
+    auto keyframeTime = [this](long long index) { return (float)(index / keyframeRate); };
+    auto storeKeyframe = [&](int slot) {
+      const GenerationJob &job = generationJob;
+      generateMs += job.ms;
+      uploadBytes += uploadVertices(generator, slot == 0 ? VBO : keyframeVBO, job.count);
+      pair.index[slot] = job.keyframe;
+      pair.count[slot] = job.count;
+      pair.tessellationLevel[slot] = job.tessellationLevel;
+    };
 
-        float x = (majorRadius + minorRadius * cos(v)) * cos(u);
-        float y = minorRadius * sin(v);
-        float z = (majorRadius + minorRadius * cos(v)) * sin(u);
+    long long current = (long long)std::floor(t * keyframeRate);
+    int older = 1 - pair.newest;
+    if (generationDirty || pair.index[older] != current) {
+      if (!generationDirty && pair.index[pair.newest] == current) {
+        if (!takeGeneration(true) || generationJob.keyframe != current + 1) generateNow(generator, keyframeTime(current + 1), current + 1);
+        storeKeyframe(older);
+        pair.newest = older;
+      } else {
+        generateNow(generator, keyframeTime(current), current);
+        storeKeyframe(0);
+        generateNow(generator, keyframeTime(current + 1), current + 1);
+        storeKeyframe(1);
+        pair.newest = 1;
+      }
+      older = 1 - pair.newest;
 
-        vertices.push_back(x);
-        vertices.push_back(y);
-        vertices.push_back(z);
+      // A surface tessellated at another level since the older keyframe is
+      // regenerated at the new one, so the two match vertex for vertex
+      if (pair.count[older] != pair.count[pair.newest]) {
+        generateNow(generator, keyframeTime(pair.index[older]), pair.index[older], pair.tessellationLevel[pair.newest]);
+        storeKeyframe(older);
+      }
+      generationDirty = false;
+    }
+    if (!generationPending) startGeneration(generator, keyframeTime(pair.index[pair.newest] + 1), pair.index[pair.newest] + 1);
 
-        float r = 0.6f + 0.4f * cos(u + t);
-        float g = 0.6f + 0.4f * sin(v + t * 1.3f);
-        float b = 0.6f + 0.4f * sin(u + v + t * 0.7f);
+    vertexCount = pair.count[pair.newest];
+    tessellationLevel = pair.tessellationLevel[pair.newest];
+    float blend = glm::clamp((float)(t * keyframeRate - pair.index[older]), 0.0f, 1.0f);
+    keyframeMix = pair.newest == 1 ? blend : 1.0f - blend;
+  }
 
-        vertices.push_back(r);
-        vertices.push_back(g);
-        vertices.push_back(b);
+  // Sets the blend weight of the program drawing CPU vertices, and enables the second
+  // keyframe's attributes on the bound layout only while it carries weight
+  void setKeyframeBlend(GLuint program) {
+    glUniform1f(glGetUniformLocation(program, "uKeyframeMix"), keyframeMix);
+    for (GLuint location : {2u, 3u}) {
+      if (keyframeMix > 0.0f) {
+        glEnableVertexAttribArray(location);
+      } else {
+        glDisableVertexAttribArray(location);
       }
     }
   }
 
-  void generateHypotrochoid(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int numPoints = 2000 * getQualityMultiplier();
-    const float R = 1.0f + 0.3f * sin(t * 0.5f);
-    const float r = 0.3f + 0.1f * cos(t * 0.7f);
-    const float d = 0.5f + 0.2f * sin(t * 1.3f);
-
-    for (int i = 0; i < numPoints; ++i) {
-      float θ = (float)i / numPoints * 2.0f * M_PI;
-      float diff = R - r;
-      float x = diff * cos(θ) + d * cos(diff / r * θ);
-      float y = diff * sin(θ) - d * sin(diff / r * θ);
-      float z = 0.0f;
-
-      vertices.push_back(x);
-      vertices.push_back(y);
-      vertices.push_back(z);
-
-      float hue = fmodf(θ + t, 2.0f * M_PI) / (2.0f * M_PI);
-      vertices.push_back(0.5f + 0.5f * sin(2 * M_PI * hue));
-      vertices.push_back(0.5f + 0.5f * sin(2 * M_PI * hue + 2.0f));
-      vertices.push_back(0.5f + 0.5f * sin(2 * M_PI * hue + 4.0f));
+  // Floats per CPU-generated vertex: (x, y, z, r, g, b), (x, y, r, g, b) for planar
+  // modes or (x, y, z, s) for scalar-colored ones
+  static int vertexFloats(const GeneratorInfo &generator) {
+    switch (generator.path) {
+      case DrawPath::CpuPlanar:
+        return 5;
+      case DrawPath::CpuScalar:
+        return 4;
+      default:
+        return 6;
     }
   }
 
-  void generateSuperformula(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int numPoints = 1000 * getQualityMultiplier();
-    float m = 6.0f + 4.0f * sin(t * 0.4f);
-    float n1 = 0.3f + 1.2f * fabs(sin(t * 0.6f));
-    float n2 = 1.0f + 2.0f * fabs(cos(t * 0.5f));
-    float n3 = 1.0f + 2.0f * fabs(sin(t * 0.8f));
-    const float a = 1, b = 1;
+  // Modes whose generator writes vertices on the CPU, in any of the three layouts
+  static bool generatesVertices(const GeneratorInfo &generator) {
+    return generator.path == DrawPath::CpuVertices || generator.path == DrawPath::CpuPlanar || generator.path == DrawPath::CpuScalar;
+  }
 
-    for (int i = 0; i < numPoints; ++i) {
-      float φ = (float)i / numPoints * 2.0f * M_PI;
-      float cos_m = cos(m * φ / 4.0f) / a;
-      float sin_m = sin(m * φ / 4.0f) / b;
-      float r = powf(powf(fabs(cos_m), n2) + powf(fabs(sin_m), n3), -1.0f / n1);
-      float x = r * cos(φ);
-      float y = r * sin(φ);
-      float z = 0.0f;
+  // The one place a parametric surface is dispatched to its tessellation level
+  GenerateFn generatorFor(const GeneratorInfo &generator, int level) const {
+    return generator.lod ? generator.lod->kernels[level] : generator.generate;
+  }
 
-      vertices.push_back(x);
-      vertices.push_back(y);
-      vertices.push_back(z);
+  // Coarsest tessellation whose chord error stays within the quality's pixel
+  // target (the one adaptive curves use) at the surface's nearest possible point
+  int selectTessellation(const SurfaceLod &lod) {
+    const float tolerance = objectSpaceTolerance(1.0f / getQualityMultiplier(), lod.radius);
+    int level = 0;
+    for (float error = lod.chordError; error > tolerance && level < tessellationLevels - 1; error *= 0.25f) ++level;
+    return level;
+  }
 
-      vertices.push_back(0.5f + 0.5f * r);
-      vertices.push_back(0.3f + 0.7f * (1 - r));
-      vertices.push_back(0.5f + 0.5f * sin(t + φ));
+  // Index buffer for `strips` consecutive strips of `length` vertices, each
+  // followed by the restart index. Rebuilt only when the layout changes.
+  void ensureStripIndices(size_t strips, size_t length) {
+    size_t count = strips * (length + 1);
+    if (count == stripIndexCount && length == stripIndexLength) return;
+
+    waitForGeneration();  // The frame arena belongs to the job while one runs
+    GLuint *indices = frameArena.alloc<GLuint>(count);
+    GLuint *index = indices;
+    for (size_t strip = 0; strip < strips; ++strip) {
+      for (size_t i = 0; i < length; ++i) *index++ = (GLuint)(strip * length + i);
+      *index++ = 0xFFFFFFFFu;
     }
-  }
 
-  void generateLorenzAttractor(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int steps = 5000 * getQualityMultiplier();
-    float dt = 0.005f;
-    float σ = 10.0f + 5.0f * sin(t * 0.3f);
-    float ρ = 28.0f + 10.0f * cos(t * 0.5f);
-    float β = 8.0f / 3.0f;
-    float x = 0.1f, y = 0.0f, z = 0.0f;
+    if (!stripIndexBuffer) glGenBuffers(1, &stripIndexBuffer);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, stripIndexBuffer);
+    gpuBuffers.allocate(GL_ELEMENT_ARRAY_BUFFER, stripIndexBuffer, count * sizeof(GLuint), indices, GL_STATIC_DRAW);
+    stripIndexCount = count;
+    stripIndexLength = length;
+  }
 
-    for (int i = 0; i < steps; ++i) {
-      float dx = σ * (y - x);
-      float dy = x * (ρ - z) - y;
-      float dz = x * y - β * z;
-      x += dx * dt;
-      y += dy * dt;
-      z += dz * dt;
+  void setTransformUniforms(GLuint program, const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &projection) {
+    glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(glGetUniformLocation(program, "view"), 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+  }
 
-      vertices.push_back(x * 0.1f);
-      vertices.push_back(y * 0.1f - 0.5f);
-      vertices.push_back(z * 0.1f - 0.5f);
+  // Uploads a heightfield's static grid when it is missing or was built for a
+  // different quality level. The CPU copy only lives in the frame arena.
+  void ensureHeightfieldMesh(const GeneratorInfo &generator) {
+    HeightfieldMesh &mesh = this->*generator.mesh;
+    if (mesh.builtQuality == qualityLevel) return;
+
+    // No generation job runs in these modes to reset the arena, so reset it here
+    waitForGeneration();
+    frameArena.reset();
+    float *grid = frameArena.alloc<float>(generator.maxVertices(getQualityMultiplier()) * 3);
+    mesh.vertexCount = (this->*generator.generate)(grid, 0.0f);
+    if (generator.primitive == GL_POINTS) {
+      float *chunked = frameArena.alloc<float>(mesh.vertexCount * 3);
+      buildHeightfieldChunks(mesh, grid, chunked);
+      grid = chunked;
+    }
 
-      float speed = sqrtf(dx * dx + dy * dy + dz * dz);
-      vertices.push_back(fminf(1.0f, speed * 0.05f));
-      vertices.push_back(0.2f + 0.8f * fabs(sinf(speed + t)));
-      vertices.push_back(1.0f - fminf(1.0f, speed * 0.05f));
+    if (!mesh.vao) {
+      glGenVertexArrays(1, &mesh.vao);
+      glGenBuffers(1, &mesh.vbo);
     }
+    glBindVertexArray(mesh.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    gpuBuffers.allocate(GL_ARRAY_BUFFER, mesh.vbo, mesh.vertexCount * 3 * sizeof(float), grid, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(0);
+    mesh.builtQuality = qualityLevel;
   }
 
-  void generateKleinBottle(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int qualityMult = getQualityMultiplier();
-    const int uSeg = 100 * qualityMult, vSeg = 50 * qualityMult;
-    float r = 1.5f + 0.3f * sin(t);
+  static int gridVertexLevel(int i, int j) {
+    int level = 0;
+    while (level < heightfieldLevels - 1 && ((i | j) & (1 << level)) == 0) ++level;
+    return level;
+  }
 
-    for (int iu = 0; iu < uSeg; ++iu) {
-      for (int iv = 0; iv < vSeg; ++iv) {
-        float u = (float)iu / uSeg * 2.0f * M_PI;
-        float v = (float)iv / vSeg * 2.0f * M_PI;
-        float x = (r + cos(u / 2) * sin(v) - sin(u / 2) * sin(2 * v)) * cos(u);
-        float y = (r + cos(u / 2) * sin(v) - sin(u / 2) * sin(2 * v)) * sin(u);
-        float z = sin(u / 2) * sin(v) + cos(u / 2) * sin(2 * v);
-
-        vertices.push_back(x * 0.3f);
-        vertices.push_back(y * 0.3f);
-        vertices.push_back(z * 0.3f);
-
-        vertices.push_back(0.5f + 0.5f * sin(u + t));
-        vertices.push_back(0.5f + 0.5f * cos(v + t * 1.2f));
-        vertices.push_back(0.5f + 0.5f * sin(u + v + t * 0.7f));
+  // Reorders a row-major square point grid into chunks, each sorted coarsest level
+  // first, and records their x/z bounds and level prefixes. The aux component of
+  // each vertex becomes its level.
+  static void buildHeightfieldChunks(HeightfieldMesh &mesh, const float *grid, float *out) {
+    const int size = (int)std::lround(std::sqrt((double)mesh.vertexCount));
+    const int chunksPerSide = (size + heightfieldChunkCells - 1) / heightfieldChunkCells;
+    const float *start = out;
+
+    mesh.chunks.clear();
+    for (int ci = 0; ci < chunksPerSide; ++ci) {
+      for (int cj = 0; cj < chunksPerSide; ++cj) {
+        const int i0 = ci * heightfieldChunkCells, i1 = std::min(i0 + heightfieldChunkCells, size);
+        const int j0 = cj * heightfieldChunkCells, j1 = std::min(j0 + heightfieldChunkCells, size);
+        HeightfieldChunk chunk;
+        chunk.first = (GLint)((out - start) / 3);
+        chunk.minX = chunk.minZ = std::numeric_limits<float>::max();
+        chunk.maxX = chunk.maxZ = -std::numeric_limits<float>::max();
+
+        for (int level = heightfieldLevels - 1; level >= 0; --level) {
+          for (int i = i0; i < i1; ++i) {
+            for (int j = j0; j < j1; ++j) {
+              if (gridVertexLevel(i, j) != level) continue;
+              const float *vertex = grid + ((size_t)i * size + j) * 3;
+              out[0] = vertex[0];
+              out[1] = vertex[1];
+              out[2] = (float)level;
+              out += 3;
+              chunk.minX = std::min(chunk.minX, vertex[0]);
+              chunk.maxX = std::max(chunk.maxX, vertex[0]);
+              chunk.minZ = std::min(chunk.minZ, vertex[1]);
+              chunk.maxZ = std::max(chunk.maxZ, vertex[1]);
+            }
+          }
+          chunk.levelCounts[level] = (GLsizei)((out - start) / 3) - chunk.first;
+        }
+        mesh.chunks.push_back(chunk);
       }
     }
+    mesh.drawFirsts.resize(mesh.chunks.size());
+    mesh.drawCounts.resize(mesh.chunks.size());
   }
 
-  void generateGyroid(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int base = 50;
-    const int qm = getQualityMultiplier();  // 1,2,4,8
-    const int grid = base * qm;             // 50,100,200,400
-    // then maybe cap it
-    const int maxGrid = 120;
-    const int finalGrid = std::min(grid, maxGrid);
-    float level = sin(t * 0.6f) * 0.5f;
-
-    for (int i = 0; i < finalGrid; ++i) {
-      for (int j = 0; j < finalGrid; ++j) {
-        for (int k = 0; k < finalGrid; ++k) {
-          float x = (i / (float)finalGrid - 0.5f) * 4.0f;
-          float y = (j / (float)finalGrid - 0.5f) * 4.0f;
-          float z = (k / (float)finalGrid - 0.5f) * 4.0f;
-          float v = sin(x) * cos(y) + sin(y) * cos(z) + sin(z) * cos(x);
+  // True unless all eight corners of the box are outside the same clip plane
+  static bool boxInFrustum(const glm::mat4 &clip, const glm::vec3 &lo, const glm::vec3 &hi) {
+    int outside[6] = {0, 0, 0, 0, 0, 0};
+    for (int corner = 0; corner < 8; ++corner) {
+      glm::vec4 p = clip * glm::vec4(corner & 1 ? hi.x : lo.x, corner & 2 ? hi.y : lo.y, corner & 4 ? hi.z : lo.z, 1.0f);
+      outside[0] += p.x < -p.w;
+      outside[1] += p.x > p.w;
+      outside[2] += p.y < -p.w;
+      outside[3] += p.y > p.w;
+      outside[4] += p.z < -p.w;
+      outside[5] += p.z > p.w;
+    }
+    for (int plane = 0; plane < 6; ++plane) {
+      if (outside[plane] == 8) return false;
+    }
+    return true;
+  }
 
-          if (fabs(v - level) < 0.05f) {
-            vertices.push_back(x);
-            vertices.push_back(y);
-            vertices.push_back(z);
-
-            float c = (v - level + 0.05f) / 0.1f;
-            vertices.push_back(c);
-            vertices.push_back(1.0f - c);
-            vertices.push_back(0.5f + 0.5f * sin(t));
-          }
-        }
-      }
+  // Fills the mesh's draw lists with the chunks inside the frustum, each cut to the
+  // level of its point nearest the camera. The vertex shader fades out the finer
+  // levels continuously, so the cut never removes a visible vertex. Returns the
+  // number of draws.
+  GLsizei selectHeightfieldChunks(HeightfieldMesh &mesh, const glm::mat4 &modelView, const glm::mat4 &projection, float spacing,
+                                  float lodDistance) {
+    const glm::mat4 clip = projection * modelView;
+    const glm::vec3 camera = glm::vec3(glm::inverse(modelView)[3]);  // In grid space
+    // Sprites reach past the vertices by up to half their size at the coarsest level
+    const float pad = 0.5f * spacing * pointOverlap * (1 << (heightfieldLevels - 1));
+
+    mesh.drawnChunks = mesh.drawnVertices = 0;
+    for (const HeightfieldChunk &chunk : mesh.chunks) {
+      glm::vec3 lo(chunk.minX - pad, -mesh.heightBound - pad, chunk.minZ - pad);
+      glm::vec3 hi(chunk.maxX + pad, mesh.heightBound + pad, chunk.maxZ + pad);
+      if (!boxInFrustum(clip, lo, hi)) continue;
+
+      float distance = glm::length(glm::clamp(camera, lo, hi) - camera);
+      int level = distance > lodDistance ? std::min((int)std::log2(distance / lodDistance), heightfieldLevels - 1) : 0;
+      mesh.drawFirsts[mesh.drawnChunks] = chunk.first;
+      mesh.drawCounts[mesh.drawnChunks] = chunk.levelCounts[level];
+      mesh.drawnVertices += chunk.levelCounts[level];
+      mesh.drawnChunks++;
     }
+    return mesh.drawnChunks;
   }
 
-  void generateSphericalHarmonic(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int qualityMult = getQualityMultiplier();
-    const int latSeg = 40 * qualityMult, lonSeg = 80 * qualityMult;
-    int ℓ = 2 + (int)(2.0f * fabs(sin(t * 0.3f)));
-    int m = ℓ / 2;
-    float eps = 0.2f + 0.3f * fabs(cos(t * 0.4f));
+  void toggleHeightfieldLod() {
+    heightfieldLod = !heightfieldLod;
+    std::cout << "Heightfield chunk culling and LOD: " << (heightfieldLod ? "on" : "off") << "\n";
+  }
 
-    for (int i = 0; i <= latSeg; ++i) {
-      float θ = M_PI * i / latSeg;
-      for (int j = 0; j <= lonSeg; ++j) {
-        float φ = 2.0f * M_PI * j / lonSeg;
-        float Y = sph_legendre(ℓ, m, cos(θ)) * cos(m * φ);
-        float R = 1.0f + eps * Y;
-        float x = R * sin(θ) * cos(φ);
-        float y = R * sin(θ) * sin(φ);
-        float z = R * cos(θ);
+  // Grid spacing on screen, in pixels, below which a heightfield drops to the next level
+  static constexpr float heightfieldLodPixels = 2.0f;
 
-        vertices.push_back(x);
-        vertices.push_back(y);
-        vertices.push_back(z);
+  void setSineSurfaceUniforms(GLuint program, float t) { glUniform1f(glGetUniformLocation(program, "uTime"), t); }
 
-        vertices.push_back(0.5f + 0.5f * Y);
-        vertices.push_back(0.5f - 0.5f * Y);
-        vertices.push_back(0.3f + 0.7f * fabs(sin(t + φ)));
+  void setWaveInterferenceUniforms(GLuint program, float t) {
+    float k1 = 2.0f + sin(t * 0.3f), k2 = 3.0f + cos(t * 0.4f);
+    float ω1 = 1.5f + cos(t * 0.5f), ω2 = 1.0f + sin(t * 0.6f);
+    glUniform1f(glGetUniformLocation(program, "uTime"), t);
+    glUniform1f(glGetUniformLocation(program, "k1"), k1);
+    glUniform1f(glGetUniformLocation(program, "k2"), k2);
+    glUniform1f(glGetUniformLocation(program, "omega1"), ω1);
+    glUniform1f(glGetUniformLocation(program, "omega2"), ω2);
+  }
+
+  void setSpacetimeUniforms(GLuint program, float) {
+    glUniform1f(glGetUniformLocation(program, "centralMass"), centralMass);
+    glUniform1f(glGetUniformLocation(program, "maxDeformation"), maxDeformation);
+  }
+
+  void drawHeightfield(const GeneratorInfo &generator, const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &projection, float t) {
+    ensureHeightfieldMesh(generator);
+    HeightfieldMesh &mesh = this->*generator.mesh;
+    GLuint program = this->*generator.program;
+
+    glUseProgram(program);
+    setTransformUniforms(program, model, view, projection);
+    if (generator.setUniforms) (this->*generator.setUniforms)(program, t);
+
+    glBindVertexArray(mesh.vao);
+    if (generator.primitive == GL_POINTS) {
+      // Levels step at distances where the grid spacing shrinks to heightfieldLodPixels
+      float spacing = pointSpacing(generator);
+      float lodDistance = heightfieldLod ? spacing * pixelsPerUnit(projection) / heightfieldLodPixels : std::numeric_limits<float>::max();
+      glUniform1f(glGetUniformLocation(program, "uLodDistance"), lodDistance);
+      glUniform1f(glGetUniformLocation(program, "uMaxLod"), (float)(heightfieldLevels - 1));
+
+      beginPointSprites(program, generator, projection);
+      if (heightfieldLod) {
+        GLsizei draws = selectHeightfieldChunks(mesh, view * model, projection, spacing, lodDistance);
+        glMultiDrawArrays(GL_POINTS, mesh.drawFirsts.data(), mesh.drawCounts.data(), draws);
+      } else {
+        glDrawArrays(GL_POINTS, 0, mesh.vertexCount);
+        mesh.drawnChunks = (GLsizei)mesh.chunks.size();
+        mesh.drawnVertices = mesh.vertexCount;
       }
+      endPointSprites();
+    } else {
+      glLineWidth(2.0f);
+      glDrawArrays(generator.primitive, 0, mesh.vertexCount);
     }
   }
 
-  void generateFractalZoom(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int res = 200 * sqrt(getQualityMultiplier());
-    float zoom = 1.5f + 0.5f * sin(t * 0.2f);
-    float cx = -0.5f + 0.2f * cos(t * 0.3f);
-    float cy = 0.0f + 0.2f * sin(t * 0.4f);
+  // Point modes draw round, anti-aliased sprites. The vertex shader sizes them from
+  // depth and the spacing between samples (the mode's sample count spread over its
+  // domain), so lower quality levels give larger sprites rather than holes.
+  // Additive blending (;) accumulates dense regions without depth sorting.
+  void beginPointSprites(GLuint program, const GeneratorInfo &generator, const glm::mat4 &projection) {
+    glUniform1f(glGetUniformLocation(program, "uPointSpacing"), pointSpacing(generator) * pointOverlap);
+    glUniform1f(glGetUniformLocation(program, "uPixelsPerUnit"), pixelsPerUnit(projection));
+    glUniform1i(glGetUniformLocation(program, "uAdditive"), additivePoints);
+
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glEnable(GL_BLEND);
+    if (additivePoints) {
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+      glDepthMask(GL_FALSE);
+    } else {
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+  }
 
-    for (int i = 0; i < res; ++i) {
-      for (int j = 0; j < res; ++j) {
-        float x0 = (i / (float)res - 0.5f) * zoom + cx;
-        float y0 = (j / (float)res - 0.5f) * zoom + cy;
-        float x = 0, y = 0;
-        int iter = 0, maxI = 100;
-
-        while (x * x + y * y < 4.0f && iter < maxI) {
-          float xt = x * x - y * y + x0;
-          y = 2 * x * y + y0;
-          x = xt;
-          ++iter;
-        }
+  // World-space distance between neighbouring samples of a point mode
+  float pointSpacing(const GeneratorInfo &generator) {
+    size_t samples = std::max<size_t>(1, generator.maxVertices(getQualityMultiplier()));
+    return generator.pointExtent / std::pow((float)samples, 1.0f / generator.pointDimensions);
+  }
 
-        float h = iter / (float)maxI;
-        vertices.push_back(i / (float)res - 0.5f);
-        vertices.push_back(h * 1.0f - 0.5f);
-        vertices.push_back(j / (float)res - 0.5f);
+  // Pixels covered by one world unit at unit view distance
+  float pixelsPerUnit(const glm::mat4 &projection) const { return 0.5f * windowHeight * projection[1][1]; }
 
-        vertices.push_back(h);
-        vertices.push_back(0.5f * h);
-        vertices.push_back(1.0f - h);
-      }
-    }
+  void endPointSprites() {
+    glDisable(GL_PROGRAM_POINT_SIZE);
+    glDisable(GL_BLEND);
+    glDepthMask(GL_TRUE);
   }
 
-  void generatePhyllotaxis(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int seeds = 1000 * getQualityMultiplier();
-    float angle0 = (1.6180339887f + 0.1f * sin(t * 0.5f)) * M_PI;
+  // Sprite diameter over sample spacing; above sqrt(2) so square grids close diagonally
+  static constexpr float pointOverlap = 1.5f;
+
+  void drawCpuPoints(const GeneratorInfo &generator, const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &projection) {
+    bool scalar = generator.path == DrawPath::CpuScalar;
+    if (scalar && !scalarColormap) scalarColormap = createColormapTexture(colormaps[colormapIndex].stops, 9);
+
+    glUseProgram(pointProgram);
+    setTransformUniforms(pointProgram, model, view, projection);
+    glUniform1i(glGetUniformLocation(pointProgram, "uScalarColor"), scalar);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_1D, scalarColormap);
+    glUniform1i(glGetUniformLocation(pointProgram, "uColormap"), 0);
+    glBindVertexArray(scalar ? scalarVAO : generator.path == DrawPath::CpuPlanar ? planarVAO : VAO);
+    setKeyframeBlend(pointProgram);
+
+    beginPointSprites(pointProgram, generator, projection);
+    glDrawArrays(GL_POINTS, 0, vertexCount);
+    endPointSprites();
+  }
 
-    for (int n = 0; n < seeds; ++n) {
-      float θ = n * angle0;
-      float r = 0.02f * sqrtf(n);
-      float x = r * cos(θ);
-      float y = r * sin(θ);
-      float z = 0.0f;
+  // Whether the uploaded vertices fit in one texture buffer view, as the polyline shader reads them
+  bool polylineFits(const GeneratorInfo &generator) const {
+    return vertexCount >= 2 && vertexCount * vertexFloats(generator) <= (size_t)maxTextureBufferTexels;
+  }
 
-      vertices.push_back(x);
-      vertices.push_back(y);
-      vertices.push_back(z);
+  // Draws the uploaded line strip(s) as quads of lineWidth pixels, one instance per
+  // segment. Coverage is blended at the edges, so the quads are anti-aliased
+  // without multisampling.
+  void drawPolyline(const GeneratorInfo &generator, const glm::mat4 &transform) {
+    if (!scalarColormap) scalarColormap = createColormapTexture(colormaps[colormapIndex].stops, 9);
+    int stride = vertexFloats(generator);
+    bool planar = generator.path == DrawPath::CpuPlanar;
+    bool scalar = generator.path == DrawPath::CpuScalar;
+
+    glUseProgram(polylineProgram);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, polylineTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, VBO);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_1D, scalarColormap);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_BUFFER, keyframeMix > 0.0f ? keyframeTexture : polylineTexture);
+    if (keyframeMix > 0.0f) glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, keyframeVBO);
+    glUniform1i(glGetUniformLocation(polylineProgram, "uVertices"), 0);
+    glUniform1i(glGetUniformLocation(polylineProgram, "uColormap"), 1);
+    glUniform1i(glGetUniformLocation(polylineProgram, "uNextVertices"), 2);
+    glUniform1f(glGetUniformLocation(polylineProgram, "uKeyframeMix"), keyframeMix);
+    glUniform1i(glGetUniformLocation(polylineProgram, "uStride"), stride);
+    glUniform1i(glGetUniformLocation(polylineProgram, "uPositionComponents"), planar ? 2 : 3);
+    glUniform1i(glGetUniformLocation(polylineProgram, "uColorOffset"), planar ? 2 : 3);
+    glUniform1i(glGetUniformLocation(polylineProgram, "uScalarColor"), scalar);
+    glUniform1i(glGetUniformLocation(polylineProgram, "uVertexCount"), (GLint)vertexCount);
+    glUniform1i(glGetUniformLocation(polylineProgram, "uStripLength"), (GLint)generator.stripLength);
+    glUniformMatrix4fv(glGetUniformLocation(polylineProgram, "uTransform"), 1, GL_FALSE, glm::value_ptr(transform));
+    glUniform2f(glGetUniformLocation(polylineProgram, "uViewport"), (float)windowWidth, (float)windowHeight);
+    glUniform1f(glGetUniformLocation(polylineProgram, "uWidth"), lineWidth);
+    glUniform1i(glGetUniformLocation(polylineProgram, "uMiter"), lineMiter);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBindVertexArray(polylineVAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)(vertexCount - 1));
+    glDisable(GL_BLEND);
+    glActiveTexture(GL_TEXTURE0);
+  }
 
-      vertices.push_back(0.5f + 0.5f * sin(θ + t));
-      vertices.push_back(0.5f + 0.5f * cos(θ + t * 1.2f));
-      vertices.push_back(0.5f + 0.5f * sin(t));
-    }
+  // Builds a 1D colormap texture that linearly interpolates the given RGB stops
+  GLuint createColormapTexture(const float *rgbStops, int stopCount) {
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_1D, texture);
+    glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB32F, stopCount, 0, GL_RGB, GL_FLOAT, rgbStops);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    return texture;
   }
 
-  void generateTesseract4D(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    std::vector<std::array<float, 4>> pts4;
-    for (int i = 0; i < 16; i++) {
-      std::array<float, 4> v;
-      for (int d = 0; d < 4; d++) v[d] = (i & (1 << d)) ? 1.0f : -1.0f;
-      pts4.push_back(v);
+  // Streams `cells` heights into the grid's texture buffer, unless `heights` is NULL,
+  // and draws one point per uploaded cell. Returns the bytes uploaded.
+  size_t drawHeightStream(const GeneratorInfo &generator, const float *heights, size_t cells, const glm::mat4 &model, const glm::mat4 &view,
+                          const glm::mat4 &projection) {
+    HeightStream &stream = this->*generator.stream;
+    GLuint program = this->*generator.program;
+    if (!stream.vao) {
+      glGenVertexArrays(1, &stream.vao);
+      glGenBuffers(1, &stream.buffer);
+      glGenTextures(1, &stream.texture);
     }
-
-    float c = cos(t * 0.3f), s = sin(t * 0.3f);
-    for (auto &v : pts4) {
-      float x = v[0], w = v[3];
-      v[0] = c * x - s * w;
-      v[3] = s * x + c * w;
+    if (!stream.colormap) {
+      // Matches the original fractal coloring (h, 0.5h, 1 - h)
+      const float stops[] = {0.0f, 0.0f, 1.0f, 1.0f, 0.5f, 0.0f};
+      stream.colormap = createColormapTexture(stops, 2);
     }
 
-    float dist = 3.0f + sin(t * 0.5f);
-    for (auto &v : pts4) {
-      float w = 1.0f / (dist - v[3]);
-      float x = v[0] * w, y = v[1] * w, z = v[2] * w;
-
-      vertices.push_back(x);
-      vertices.push_back(y);
-      vertices.push_back(z);
-
-      vertices.push_back(0.5f + 0.5f * (v[3]));
-      vertices.push_back(1.0f - 0.5f * (v[3]));
-      vertices.push_back(0.5f + 0.5f * sin(t));
+    size_t bytes = heights ? cells * sizeof(float) : 0;
+    if (heights) {
+      glBindBuffer(GL_TEXTURE_BUFFER, stream.buffer);
+      if (bytes > gpuBuffers.size(stream.buffer)) {
+        gpuBuffers.allocate(GL_TEXTURE_BUFFER, stream.buffer, bytes, heights, GL_STREAM_DRAW);
+      } else {
+        gpuBuffers.allocate(GL_TEXTURE_BUFFER, stream.buffer, gpuBuffers.size(stream.buffer), NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, bytes, heights);
+      }
+      stream.cells = cells;
     }
+
+    glUseProgram(program);
+    setTransformUniforms(program, model, view, projection);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, stream.texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, stream.buffer);
+    glUniform1i(glGetUniformLocation(program, "uHeights"), 0);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_1D, stream.colormap);
+    glUniform1i(glGetUniformLocation(program, "uColormap"), 1);
+    glActiveTexture(GL_TEXTURE0);
+
+    glUniform1i(glGetUniformLocation(program, "uGridResolution"), stream.resolution);
+    glUniform2fv(glGetUniformLocation(program, "uGridOrigin"), 1, stream.origin);
+    glUniform2fv(glGetUniformLocation(program, "uGridSpacing"), 1, stream.spacing);
+    glUniform1f(glGetUniformLocation(program, "uHeightScale"), stream.heightScale);
+    glUniform1f(glGetUniformLocation(program, "uHeightOffset"), stream.heightOffset);
+
+    glBindVertexArray(stream.vao);
+    beginPointSprites(program, generator, projection);
+    glDrawArrays(GL_POINTS, 0, stream.cells);
+    endPointSprites();
+    return bytes;
   }
 
-  void generateWaveInterference(std::vector<float> &vertices, float t) {
-    vertices.clear();
-    const int grid = 100 * sqrt(getQualityMultiplier());
-    const float size = 4.0f;
-    float k1 = 2.0f + sin(t * 0.3f), k2 = 3.0f + cos(t * 0.4f);
-    float ω1 = 1.5f + cos(t * 0.5f), ω2 = 1.0f + sin(t * 0.6f);
+  // 125K particles at Low up to 1M at Ultra
+  static size_t countAttractorParticles(int qualityMult) { return 125000 * qualityMult; }
 
-    for (int i = 0; i < grid; i++) {
-      for (int j = 0; j < grid; j++) {
-        float x = (i / (float)grid - 0.5f) * size;
-        float z = (j / (float)grid - 0.5f) * size;
-        float y = 0.5f * (sin(k1 * x - ω1 * t) + sin(k2 * z - ω2 * t));
-
-        vertices.push_back(x);
-        vertices.push_back(y);
-        vertices.push_back(z);
-
-        float h = (y + 1.0f) * 0.5f;
-        vertices.push_back(h);
-        vertices.push_back(1.0f - h);
-        vertices.push_back(0.5f + 0.5f * sin(t));
+  // (Re)creates the state buffers for the current quality level and reseeds them
+  // on the GPU when the particle count or vector field changed
+  void ensureParticleSystem() {
+    GLsizei count = countAttractorParticles(getQualityMultiplier());
+    if (particles.count == count && particles.field == attractorField) return;
+
+    if (!particles.vao[0]) {
+      glGenVertexArrays(2, particles.vao);
+      glGenBuffers(2, particles.vbo);
+    }
+    if (particles.count != count) {
+      for (int i = 0; i < 2; ++i) {
+        glBindVertexArray(particles.vao[i]);
+        glBindBuffer(GL_ARRAY_BUFFER, particles.vbo[i]);
+        gpuBuffers.allocate(GL_ARRAY_BUFFER, particles.vbo[i], count * 4 * sizeof(float), NULL, GL_DYNAMIC_COPY);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
+        glEnableVertexAttribArray(0);
       }
+      particles.count = count;
     }
+
+    particles.field = attractorField;
+    particles.seed++;
+    advanceParticles(0.0f, true);
   }
 
-  void generateGravitationalSpacetime(std::vector<float> &vertices, float t) {
-    GLuint VAO, VBO;
-        vertices.clear();
-        
-        const int gridSize = 80;
-        const float extent = 4.0f;
-        const int gridLines = 15;
-        
-        // Surface mesh with gravitational deformation
-        for (int i = 0; i < gridSize; ++i) {
-            float x = (float(i) / (gridSize - 1)) * 2.0f * extent - extent;
-            for (int j = 0; j < gridSize; ++j) {
-                float z = (float(j) / (gridSize - 1)) * 2.0f * extent - extent;
-                
-                float r = std::sqrt(x*x + z*z);
-                float y = 0.0f;
-                
-                if (r < extent) {
-                    // Realistic gravitational well formula
-                    float t = r / extent;
-                    float depth = centralMass * maxDeformation;
-                    
-                    // Combination of steep center and smooth edges
-                    float steepness = 4.0f * centralMass;
-                    float well = 1.0f / (1.0f + steepness * t * t);
-                    float parabolic = (1.0f - t * t);
-                    float blend = std::exp(-3.0f * t);
-                    
-                    y = -depth * (blend * well + (1.0f - blend) * parabolic);
-                }
-                
-                // Add vertex with grey color
-                vertices.insert(vertices.end(), {x, y, z, 0.6f, 0.6f, 0.6f});
-            }
-        }
-        
-        // Grid lines overlaid on surface
-        for (int line = 0; line < gridLines; ++line) {
-            float coord = (float(line) / (gridLines - 1)) * 2.0f * extent - extent;
-            
-            // Vertical grid lines
-            for (int j = 0; j < gridSize; j += 3) {
-                float z = (float(j) / (gridSize - 1)) * 2.0f * extent - extent;
-                float r = std::sqrt(coord*coord + z*z);
-                float y = 0.01f; // Slightly above surface
-                
-                if (r < extent) {
-                    float t = r / extent;
-                    float depth = centralMass * maxDeformation;
-                    float steepness = 4.0f * centralMass;
-                    float well = 1.0f / (1.0f + steepness * t * t);
-                    float parabolic = (1.0f - t * t);
-                    float blend = std::exp(-3.0f * t);
-                    
-                    y = -depth * (blend * well + (1.0f - blend) * parabolic) + 0.01f;
-                }
-                
-                vertices.insert(vertices.end(), {coord, y, z, 1.0f, 1.0f, 1.0f});
-            }
-            
-            // Horizontal grid lines  
-            for (int i = 0; i < gridSize; i += 3) {
-                float x = (float(i) / (gridSize - 1)) * 2.0f * extent - extent;
-                float r = std::sqrt(x*x + coord*coord);
-                float y = 0.01f;
-                
-                if (r < extent) {
-                    float t = r / extent;
-                    float depth = centralMass * maxDeformation;
-                    float steepness = 4.0f * centralMass;
-                    float well = 1.0f / (1.0f + steepness * t * t);
-                    float parabolic = (1.0f - t * t);
-                    float blend = std::exp(-3.0f * t);
-                    
-                    y = -depth * (blend * well + (1.0f - blend) * parabolic) + 0.01f;
-                }
-                
-                vertices.insert(vertices.end(), {x, y, coord, 1.0f, 1.0f, 1.0f});
-            }
-        }        
+  // One transform feedback pass from the current state buffer into the other
+  void advanceParticles(float t, bool reseed) {
+    const AttractorField &field = attractorFields[attractorField];
+    float params[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    switch (attractorField) {
+      case 0:  // Lorenz, animated like the single trajectory
+        params[0] = 10.0f + 5.0f * sin(t * 0.3f);
+        params[1] = 28.0f + 10.0f * cos(t * 0.5f);
+        params[2] = 8.0f / 3.0f;
+        break;
+      case 1:  // Rossler
+        params[0] = 0.2f;
+        params[1] = 0.2f;
+        params[2] = 5.7f;
+        break;
+      case 2:  // Thomas
+        params[0] = 0.208186f;
+        break;
+      case 3:  // Aizawa
+        params[0] = 0.95f;
+        params[1] = 0.7f;
+        params[2] = 0.6f;
+        params[3] = 3.5f;
+        params[4] = 0.25f;
+        params[5] = 0.1f;
+        break;
     }
 
+    glUseProgram(particleUpdateProgram);
+    glUniform1i(glGetUniformLocation(particleUpdateProgram, "uField"), attractorField);
+    glUniform1fv(glGetUniformLocation(particleUpdateProgram, "uParams"), 6, params);
+    glUniform1f(glGetUniformLocation(particleUpdateProgram, "uDt"), field.dt);
+    glUniform1i(glGetUniformLocation(particleUpdateProgram, "uSubsteps"), field.substeps);
+    glUniform1f(glGetUniformLocation(particleUpdateProgram, "uBound"), field.bound);
+    glUniform3fv(glGetUniformLocation(particleUpdateProgram, "uSeedCenter"), 1, field.seedCenter);
+    glUniform1f(glGetUniformLocation(particleUpdateProgram, "uSeedExtent"), field.seedExtent);
+    glUniform1ui(glGetUniformLocation(particleUpdateProgram, "uSeed"), particles.seed);
+    glUniform1i(glGetUniformLocation(particleUpdateProgram, "uReseed"), reseed ? 1 : 0);
+
+    int next = 1 - particles.current;
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(particles.vao[particles.current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, particles.vbo[next]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, particles.count);
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glDisable(GL_RASTERIZER_DISCARD);
+    particles.current = next;
+  }
 
+  void drawParticles(const GeneratorInfo &generator, const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &projection, float t) {
+    ensureParticleSystem();
+    advanceParticles(t, false);
+
+    const AttractorField &field = attractorFields[attractorField];
+    glUseProgram(particleProgram);
+    setTransformUniforms(particleProgram, model, view, projection);
+    glUniform3fv(glGetUniformLocation(particleProgram, "uScale"), 1, field.scale);
+    glUniform3fv(glGetUniformLocation(particleProgram, "uOffset"), 1, field.offset);
+    glUniform1f(glGetUniformLocation(particleProgram, "uSpeedScale"), field.speedScale);
+    glUniform1f(glGetUniformLocation(particleProgram, "uTime"), t);
+
+    glBindVertexArray(particles.vao[particles.current]);
+    beginPointSprites(particleProgram, generator, projection);
+    glDrawArrays(GL_POINTS, 0, particles.count);
+    endPointSprites();
+  }
 
-  //   void generateGravitationalSpacetime(std::vector<float> &vertices, float t) {
-  //     vertices.clear();
-  //     const int gridSize = 100 * sqrt(getQualityMultiplier());
-  //     const float extent = 4.0f;
-
-  //     // Central mass position (can be animated)
-  //     float massX = 0.5f * sin(t * 0.3f);
-  //     float massZ = 0.5f * cos(t * 0.3f);
-
-  //     // Generate spacetime grid surface
-  //     for (int i = 0; i < gridSize; ++i) {
-  //       for (int j = 0; j < gridSize; ++j) {
-  //         float x = (float)i / (gridSize - 1) * extent - extent / 2.0f;
-  //         float z = (float)j / (gridSize - 1) * extent - extent / 2.0f;
-
-  //         // Distance from the central mass
-  //         float dx = x - massX;
-  //         float dz = z - massZ;
-  //         float r = sqrt(dx * dx + dz * dz);
+  // Heightmap texels for the terrain view; 4x the CPU grid's cells
+  static int fractalTerrainResolution(int qualityMult) { return 2 * fractalResolution(qualityMult); }
 
-  //         // Gravitational potential with adjustable mass
-  //         // φ = -GM/r, but we'll use a modified version to prevent singularity
-  //         float minRadius = 0.1f;  // Prevent division by zero
-  //         float effectiveRadius = std::max(r, minRadius);
+  static size_t countGpuFractal(int qualityMult) { return fractalTerrainResolution(qualityMult) * fractalTerrainResolution(qualityMult); }
 
-  //         // Spacetime curvature: y displacement proportional to gravitational potential
-  //         float gravitationalPotential = -centralMass / effectiveRadius;
+  // (Re)creates the heightmap render target for the current quality level.
+  // Returns false if the framebuffer is incomplete; the mode then stays flat.
+  bool ensureFractalHeightMap() {
+    int res = fractalTerrainResolution(getQualityMultiplier());
+    if (gpuFractal.resolution == res) return gpuFractal.complete;
 
-  //         // Apply curvature with smooth falloff
-  //         float curvature = gravitationalPotential * maxDeformation;
+    if (!gpuFractal.framebuffer) {
+      glGenFramebuffers(1, &gpuFractal.framebuffer);
+      glGenTextures(1, &gpuFractal.heightMap);
+    }
+    if (!gpuFractal.colormap) {
+      // Same coloring as the CPU fractal stream
+      const float stops[] = {0.0f, 0.0f, 1.0f, 1.0f, 0.5f, 0.0f};
+      gpuFractal.colormap = createColormapTexture(stops, 2);
+    }
 
-  //         // Add some time-based oscillation to show dynamic effects
-  //         float timeEffect = 0.1f * sin(t * 2.0f + r * 3.0f) * centralMass;
+    glBindTexture(GL_TEXTURE_2D, gpuFractal.heightMap);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, res, res, 0, GL_RED, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-  //         float y = curvature + timeEffect;
+    glBindFramebuffer(GL_FRAMEBUFFER, gpuFractal.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gpuFractal.heightMap, 0);
+    gpuFractal.complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-  //         vertices.push_back(x);
-  //         vertices.push_back(y);
-  //         vertices.push_back(z);
+    if (!gpuFractal.complete) std::cerr << "Fractal heightmap framebuffer is incomplete; drawing the flat view" << "\n";
+    gpuFractal.resolution = res;
+    return gpuFractal.complete;
+  }
 
-  //         // Color based on curvature depth and mass
-  //         float depth = -y / maxDeformation;  // Normalize depth
-  //         float redIntensity = std::min(1.0f, std::max(0.0f, depth * 0.8f + 0.2f));
-  //         float greenIntensity = std::min(1.0f, std::max(0.1f, 1.0f - depth * 0.5f));
-  //         float blueIntensity = std::min(1.0f, std::max(0.1f, 0.3f + depth * 0.4f));
+  void drawGpuFractal(const GeneratorInfo &generator, const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &projection, float t) {
+    if (!gpuFractal.vao) glGenVertexArrays(1, &gpuFractal.vao);
+    const bool terrain = fractalTerrain && ensureFractalHeightMap();
 
-  //         // Add mass-dependent coloring
-  //         float massInfluence = centralMass / 5.0f;  // Normalize to 0-1
-  //         redIntensity = std::min(1.0f, redIntensity + massInfluence * 0.3f);
+    // The Julia view is centered on the origin and wide enough for the whole set
+    FractalView fractal = fractalView(t);
+    if (fractalJulia) {
+      fractal.zoom *= 2.0f;
+      fractal.cx += 0.5f;
+    }
 
-  //         vertices.push_back(redIntensity);
-  //         vertices.push_back(greenIntensity);
-  //         vertices.push_back(blueIntensity);
-  //       }
-  //     }
+    glUseProgram(fractalProgram);
+    glUniform1f(glGetUniformLocation(fractalProgram, "uZoom"), fractal.zoom);
+    glUniform2f(glGetUniformLocation(fractalProgram, "uCenter"), fractal.cx, fractal.cy);
+    glUniform1i(glGetUniformLocation(fractalProgram, "uJulia"), fractalJulia ? 1 : 0);
+    glUniform2f(glGetUniformLocation(fractalProgram, "uJuliaC"), 0.7885f * cosf(t * 0.25f), 0.7885f * sinf(t * 0.25f));
+    glUniform1i(glGetUniformLocation(fractalProgram, "uOutputHeight"), terrain ? 1 : 0);
+    glBindVertexArray(gpuFractal.vao);
+    glDisable(GL_DEPTH_TEST);
+
+    if (!terrain) {
+      // Heights match the CPU renderer's 100 iterations; the flat view can afford more
+      glUniform2f(glGetUniformLocation(fractalProgram, "uViewport"), (float)windowWidth, (float)windowHeight);
+      glUniform1i(glGetUniformLocation(fractalProgram, "uMaxIterations"), 100 * getQualityMultiplier());
+      glDrawArrays(GL_TRIANGLES, 0, 3);
+      glEnable(GL_DEPTH_TEST);
+      return;
+    }
 
-  //     // Add the central mass as a bright sphere
-  //     const int spherePoints = 50;
-  //     for (int i = 0; i < spherePoints; ++i) {
-  //       float theta = 2.0f * M_PI * i / spherePoints;
-  //       float radius = 0.05f + 0.02f * centralMass;  // Size based on mass
+    const int res = gpuFractal.resolution;
+    glUniform2f(glGetUniformLocation(fractalProgram, "uViewport"), (float)res, (float)res);
+    glUniform1i(glGetUniformLocation(fractalProgram, "uMaxIterations"), 100);
+    glBindFramebuffer(GL_FRAMEBUFFER, gpuFractal.framebuffer);
+    glViewport(0, 0, res, res);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, windowWidth, windowHeight);
+    glEnable(GL_DEPTH_TEST);
 
-  //       float x = massX + radius * cos(theta);
-  //       float z = massZ + radius * sin(theta);
-  //       float y = -0.1f;  // Slightly above the surface
+    glUseProgram(fractalTerrainProgram);
+    setTransformUniforms(fractalTerrainProgram, model, view, projection);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, gpuFractal.heightMap);
+    glUniform1i(glGetUniformLocation(fractalTerrainProgram, "uHeightMap"), 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_1D, gpuFractal.colormap);
+    glUniform1i(glGetUniformLocation(fractalTerrainProgram, "uColormap"), 1);
+    glActiveTexture(GL_TEXTURE0);
+    glUniform1i(glGetUniformLocation(fractalTerrainProgram, "uGridResolution"), res);
+
+    beginPointSprites(fractalTerrainProgram, generator, projection);
+    glDrawArrays(GL_POINTS, 0, res * res);
+    endPointSprites();
+  }
 
-  //       vertices.push_back(x);
-  //       vertices.push_back(y);
-  //       vertices.push_back(z);
+  void toggleFractalTerrain() {
+    fractalTerrain = !fractalTerrain;
+    std::cout << "GPU fractal view: " << (fractalTerrain ? "heightmap terrain" : "flat") << "\n";
+  }
 
-  //       // Bright white/yellow for the mass
-  //       vertices.push_back(1.0f);
-  //       vertices.push_back(1.0f - 0.2f * sin(t * 3.0f));
-  //       vertices.push_back(0.3f);
-  //     }
+  void toggleFractalJulia() {
+    fractalJulia = !fractalJulia;
+    std::cout << "GPU fractal set: " << (fractalJulia ? "Julia" : "Mandelbrot") << "\n";
+  }
 
-  //     // Add grid lines to better show the curvature
-  //     const int gridLines = 20;
-  //     for (int line = 0; line < gridLines; ++line) {
-  //       // Vertical lines
-  //       float x = (float)line / (gridLines - 1) * extent - extent / 2.0f;
-  //       for (int j = 0; j < gridSize; j += 2) {
-  //         float z = (float)j / (gridSize - 1) * extent - extent / 2.0f;
+  void togglePlanarOrtho() {
+    planarOrtho = !planarOrtho;
+    std::cout << "Planar view: " << (planarOrtho ? "orthographic" : "perspective") << "\n";
+  }
 
-  //         float dx = x - massX;
-  //         float dz = z - massZ;
-  //         float r = sqrt(dx * dx + dz * dz);
-  //         float effectiveRadius = std::max(r, 0.1f);
-  //         float y = -centralMass / effectiveRadius * maxDeformation;
+  void cycleColormap() {
+    colormapIndex = (colormapIndex + 1) % colormapCount;
+    if (scalarColormap) {
+      glDeleteTextures(1, &scalarColormap);
+      scalarColormap = 0;
+    }
+    std::cout << "Colormap: " << colormaps[colormapIndex].name << "\n";
+  }
 
-  //         vertices.push_back(x);
-  //         vertices.push_back(y + 0.01f);  // Slightly above surface
-  //         vertices.push_back(z);
+  void setLineWidth(float width) {
+    lineWidth = std::max(1.0f, std::min(width, 16.0f));
+    std::cout << "Line width: " << lineWidth << " px\n";
+  }
 
-  //         vertices.push_back(0.8f);
-  //         vertices.push_back(0.8f);
-  //         vertices.push_back(0.9f);
-  //       }
+  void toggleLineJoins() {
+    lineMiter = !lineMiter;
+    std::cout << "Line joins: " << (lineMiter ? "miter" : "round") << "\n";
+  }
 
-  //       // Horizontal lines
-  //       float z = (float)line / (gridLines - 1) * extent - extent / 2.0f;
-  //       for (int i = 0; i < gridSize; i += 2) {
-  //         float x = (float)i / (gridSize - 1) * extent - extent / 2.0f;
+  // Generation of stable-topology modes drops to keyframeRate; presizing reserves the second buffer
+  void toggleKeyframes() {
+    keyframesEnabled = !keyframesEnabled;
+    presizeForMode();
+    std::cout << "Keyframe interpolation: ";
+    if (keyframesEnabled) {
+      std::cout << keyframeRate << " keyframes/s for curves and parametric surfaces\n";
+    } else {
+      std::cout << "off\n";
+    }
+  }
 
-  //         float dx = x - massX;
-  //         float dz = z - massZ;
-  //         float r = sqrt(dx * dx + dz * dz);
-  //         float effectiveRadius = std::max(r, 0.1f);
-  //         float y = -centralMass / effectiveRadius * maxDeformation;
+  void toggleAdditivePoints() {
+    additivePoints = !additivePoints;
+    std::cout << "Point blending: " << (additivePoints ? "additive" : "alpha") << "\n";
+  }
 
-  //         vertices.push_back(x);
-  //         vertices.push_back(y + 0.01f);  // Slightly above surface
-  //         vertices.push_back(z);
+  // Half-height of the orthographic view; the largest planar figures reach about 1.8
+  static constexpr float planarOrthoExtent = 2.0f;
 
-  //         vertices.push_back(0.8f);
-  //         vertices.push_back(0.8f);
-  //         vertices.push_back(0.9f);
-  //       }
-  //     }
-  //   }
+  void setHypotrochoidMaxDenominator(int bound) {
+    waitForGeneration();
+    hypotrochoidMaxDenominator = std::max(1, std::min(bound, 64));
+    std::cout << "Hypotrochoid period denominator bound: " << hypotrochoidMaxDenominator << "\n";
+  }
+
+  void cycleAttractorField() {
+    attractorField = (attractorField + 1) % attractorFieldCount;
+    std::cout << "Particle field: " << attractorFields[attractorField].name << "\n";
+  }
 
   void render() {
     // Calculate delta time for smooth movement
@@ -1131,82 +4013,47 @@ class MathAnimation {
     deltaTime = currentFrame - lastFrame;
     lastFrame = currentFrame;
 
-    // Process input for camera movement
-    processInput();
-
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     static float time = glfwGetTime();
     time = glfwGetTime();
 
-    // Generate vertices based on current animation mode
-
-    switch (animationMode) {
-      case 0:
-        generateParametricSpiral(vertices, time);
-        break;
-      case 1:
-        generateLissajous(vertices, time);
-        break;
-      case 2:
-        generate3DHelix(vertices, time);
-        break;
-      case 3:
-        generateSineWaveSurface(vertices, time);
-        break;
-      case 4:
-        generateTorus(vertices, time);
-        break;
-      case 5:
-        generateHypotrochoid(vertices, time);
-        break;
-      case 6:
-        generateSuperformula(vertices, time);
-        break;
-      case 7:
-        generateLorenzAttractor(vertices, time);
-        break;
-      case 8:
-        generateKleinBottle(vertices, time);
-        break;
-      case 9:
-        generateGyroid(vertices, time);
-        break;
-      case 10:
-        generateSphericalHarmonic(vertices, time);
-        break;
-      case 11:
-        generateFractalZoom(vertices, time);
-        break;
-      case 12:
-        generatePhyllotaxis(vertices, time);
-        break;
-      case 13:
-        generateTesseract4D(vertices, time);
+    beginFrameTelemetry();
+
+    double generateMs = 0.0;
+    size_t uploadBytes = 0;
+
+    // Take finished generation results before the camera is latched, so uploads
+    // do not add to the age of the view
+    const GeneratorInfo &generator = generators[animationMode];
+    bool heightsReady = false;
+    switch (generator.path) {
+      case DrawPath::CpuVertices:
+      case DrawPath::CpuPlanar:
+      case DrawPath::CpuScalar:
+        if (keyframed(generator)) {
+          advanceKeyframes(generator, time, generateMs, uploadBytes);
+        } else {
+          keyframeMix = 0.0f;
+          if (takeGenerationResult(generator, time, generateMs)) {
+            vertexCount = generationJob.count;
+            tessellationLevel = generationJob.tessellationLevel;
+            uploadBytes = uploadVertices(generator, VBO, vertexCount);
+          }
+          keepGenerating(generator, time);
+        }
         break;
-      case 14:
-        generateWaveInterference(vertices, time);
+      case DrawPath::HeightStream:
+        heightsReady = takeGenerationResult(generator, time, generateMs);
         break;
-      case 15:
-        generateGravitationalSpacetime(vertices, time);
+      default:
         break;
     }
 
-    // Update vertex buffer
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
-
-    // Position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void *)0);
-    glEnableVertexAttribArray(0);
-
-    // Color attribute
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void *)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Use shader program
-    glUseProgram(shaderProgram);
+    // Late latch: camera movement and matrices as of just before the draw calls
+    processInput();
+    double latchedInput = inputPendingSince;
+    inputPendingSince = -1.0;
 
     // Set up matrices
     glm::mat4 model = glm::mat4(1.0f);
@@ -1217,47 +4064,229 @@ class MathAnimation {
 
     glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)windowWidth / (float)windowHeight, 0.1f, 100.0f);
 
-    // Send matrices to shader
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    switch (generator.path) {
+      case DrawPath::GpuHeightfield:
+        // Heightfields are displaced on the GPU from a static grid
+        drawHeightfield(generator, model, view, projection, time);
+        break;
 
-    // Draw
-    if (animationMode == 3 || animationMode == 9 || animationMode == 11 || animationMode == 14) {
-      glPointSize(2.0f);
-      glDrawArrays(GL_POINTS, 0, vertices.size() / 6);
-    } else {
-      glLineWidth(2.0f);
-      glDrawArrays(GL_LINE_STRIP, 0, vertices.size() / 6);
+      case DrawPath::GpuParticles:
+        // Particles are advected and drawn entirely on the GPU
+        drawParticles(generator, model, view, projection, time);
+        break;
+
+      case DrawPath::GpuFractal:
+        // Escape time runs per fragment, at screen or heightmap resolution
+        drawGpuFractal(generator, model, view, projection, time);
+        break;
+
+      case DrawPath::HeightStream:
+        // Heights are computed on the CPU but streamed as one float per cell
+        uploadBytes = drawHeightStream(generator, heightsReady ? heightCells.data() : NULL, heightsReady ? generationJob.count : 0, model, view,
+                                       projection);
+        keepGenerating(generator, time);
+        break;
+
+      case DrawPath::CpuVertices:
+      case DrawPath::CpuPlanar:
+      case DrawPath::CpuScalar:
+        // One combined transform for the planar and polyline shaders; the orthographic
+        // view fits planar figures to the window
+        bool ortho = generator.path == DrawPath::CpuPlanar && planarOrtho;
+        float aspect = (float)windowWidth / (float)windowHeight;
+        glm::mat4 transform = ortho ? glm::ortho(-aspect * planarOrthoExtent, aspect * planarOrthoExtent, -planarOrthoExtent,
+                                                 planarOrthoExtent, -1.0f, 1.0f)
+                                    : projection * view * model;
+        if (ortho) glDisable(GL_DEPTH_TEST);
+
+        if (generator.primitive == GL_LINE_STRIP && polylineFits(generator)) {
+          drawPolyline(generator, transform);
+          glEnable(GL_DEPTH_TEST);
+          break;
+        }
+        if (generator.primitive == GL_POINTS) {
+          drawCpuPoints(generator, model, view, projection);
+          glEnable(GL_DEPTH_TEST);
+          break;
+        }
+        if (generator.path == DrawPath::CpuPlanar) {
+          glUseProgram(planarProgram);
+          glUniformMatrix4fv(glGetUniformLocation(planarProgram, "uTransform"), 1, GL_FALSE, glm::value_ptr(transform));
+          glBindVertexArray(planarVAO);
+          setKeyframeBlend(planarProgram);
+        } else if (generator.path == DrawPath::CpuScalar) {
+          if (!scalarColormap) scalarColormap = createColormapTexture(colormaps[colormapIndex].stops, 9);
+          glUseProgram(scalarProgram);
+          setTransformUniforms(scalarProgram, model, view, projection);
+          glActiveTexture(GL_TEXTURE0);
+          glBindTexture(GL_TEXTURE_1D, scalarColormap);
+          glUniform1i(glGetUniformLocation(scalarProgram, "uColormap"), 0);
+          glBindVertexArray(scalarVAO);
+          setKeyframeBlend(scalarProgram);
+        } else {
+          glUseProgram(shaderProgram);
+          setTransformUniforms(shaderProgram, model, view, projection);
+          glBindVertexArray(VAO);
+          setKeyframeBlend(shaderProgram);
+        }
+
+        // Lines too long for the polyline renderer
+        glLineWidth(2.0f);
+        if (generator.stripLength) {
+          // Several strips in one draw, separated by the restart index
+          ensureStripIndices(vertexCount / generator.stripLength, generator.stripLength);
+          glEnable(GL_PRIMITIVE_RESTART);
+          glPrimitiveRestartIndex(0xFFFFFFFFu);
+          glDrawElements(generator.primitive, (GLsizei)stripIndexCount, GL_UNSIGNED_INT, (void *)0);
+          glDisable(GL_PRIMITIVE_RESTART);
+        } else {
+          glDrawArrays(generator.primitive, 0, vertexCount);
+        }
+        glEnable(GL_DEPTH_TEST);
+        break;
     }
 
     glfwSwapBuffers(window);
+    if (!startup.reported) startup.firstGenerateMs = generateMs;
+
+    endFrameTelemetry(generateMs, uploadBytes, latchedInput < 0.0 ? -1.0 : (glfwGetTime() - latchedInput) * 1000.0);
+  }
+
+  void beginFrameTelemetry() {
+    frameStartAllocations = AllocTelemetry::allocations.load(std::memory_order_relaxed);
+    frameStartAllocatedBytes = AllocTelemetry::allocatedBytes.load(std::memory_order_relaxed);
+    AllocTelemetry::peakLiveBytes.store(AllocTelemetry::liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+  // `latencyMs` is the input-to-present time of this frame, or negative without input
+  void endFrameTelemetry(double generateMs, size_t uploadBytes, double latencyMs) {
+    size_t allocations = AllocTelemetry::allocations.load(std::memory_order_relaxed) - frameStartAllocations;
+    size_t allocatedBytes = AllocTelemetry::allocatedBytes.load(std::memory_order_relaxed) - frameStartAllocatedBytes;
+    size_t peakLiveBytes = AllocTelemetry::peakLiveBytes.load(std::memory_order_relaxed);
+
+    if (AllocTelemetry::enabled) {
+      if (modeMemory.size() <= (size_t)animationMode) modeMemory.resize(animationMode + 1);
+      ModeMemoryStats &mode = modeMemory[animationMode];
+      mode.frames++;
+      mode.allocations += allocations;
+      mode.allocatedBytes += allocatedBytes;
+      mode.peakLiveBytes = std::max(mode.peakLiveBytes, peakLiveBytes);
+      mode.retainedBytes = AllocTelemetry::liveBytes.load(std::memory_order_relaxed);
+    }
+
+    if (!telemetryEnabled) return;
+
+    double frameMs = deltaTime * 1000.0;
+    telemetryFrames++;
+    telemetryFrameMs += frameMs;
+    telemetryMaxFrameMs = std::max(telemetryMaxFrameMs, frameMs);
+    telemetryGenerateMs += generateMs;
+    telemetryUploadBytes += uploadBytes;
+    telemetryAllocations += allocations;
+    telemetryAllocatedBytes += allocatedBytes;
+    telemetryPeakLiveBytes = std::max(telemetryPeakLiveBytes, peakLiveBytes);
+    if (latencyMs >= 0.0) {
+      telemetryLatencyFrames++;
+      telemetryLatencyMs += latencyMs;
+      telemetryMaxLatencyMs = std::max(telemetryMaxLatencyMs, latencyMs);
+    }
+
+    double now = glfwGetTime();
+    double elapsed = now - telemetryWindowStart;
+    if (elapsed < 1.0) return;
+
+    double frames = telemetryFrames;
+    std::cout << "[stats] " << generators[animationMode].name << " | " << std::fixed << std::setprecision(1) << frames / elapsed << " fps | frame "
+              << std::setprecision(2) << telemetryFrameMs / frames << " ms (max " << telemetryMaxFrameMs << ") | generate "
+              << telemetryGenerateMs / frames << " ms | upload " << formatBytes(telemetryUploadBytes / frames) << "/frame";
+    if (telemetryLatencyFrames) {
+      std::cout << " | input-to-present " << telemetryLatencyMs / telemetryLatencyFrames << " ms (max " << telemetryMaxLatencyMs << ")";
+    }
+    if (AllocTelemetry::enabled) {
+      std::cout << " | heap " << std::setprecision(1) << telemetryAllocations / frames << " allocs, "
+                << formatBytes(telemetryAllocatedBytes / frames) << "/frame, peak live " << formatBytes(telemetryPeakLiveBytes);
+    }
+    const GeneratorInfo &generator = generators[animationMode];
+    if (generator.lod) std::cout << " | tessellation " << (1 << tessellationLevel) / 4.0 << "x";
+    if (keyframed(generator)) std::cout << " | keyframes " << keyframeRate << "/s";
+    if (generator.path == DrawPath::GpuHeightfield && !(this->*generator.mesh).chunks.empty()) {
+      const HeightfieldMesh &mesh = this->*generator.mesh;
+      std::cout << " | chunks " << mesh.drawnChunks << "/" << mesh.chunks.size() << ", " << mesh.drawnVertices << "/" << mesh.vertexCount
+                << " points";
+    }
+    std::cout << " | vertex storage " << formatBytes(vertices.capacity() * sizeof(float)) << " | GPU buffers "
+              << formatBytes(gpuBuffers.total()) << std::defaultfloat << "\n";
+
+    telemetryWindowStart = now;
+    telemetryFrames = 0;
+    telemetryFrameMs = telemetryMaxFrameMs = telemetryGenerateMs = 0.0;
+    telemetryLatencyMs = telemetryMaxLatencyMs = 0.0;
+    telemetryLatencyFrames = 0;
+    telemetryUploadBytes = telemetryAllocations = telemetryAllocatedBytes = telemetryPeakLiveBytes = 0;
+  }
+
+  void toggleTelemetry() {
+    telemetryEnabled = !telemetryEnabled;
+    telemetryWindowStart = glfwGetTime();
+    telemetryFrames = 0;
+    telemetryFrameMs = telemetryMaxFrameMs = telemetryGenerateMs = 0.0;
+    telemetryLatencyMs = telemetryMaxLatencyMs = 0.0;
+    telemetryLatencyFrames = 0;
+    telemetryUploadBytes = telemetryAllocations = telemetryAllocatedBytes = telemetryPeakLiveBytes = 0;
+    std::cout << "Telemetry " << (telemetryEnabled ? "enabled" : "disabled") << "\n";
   }
 
-  void run() {
+  void printModeMemoryReport() {
+    if (!AllocTelemetry::enabled) return;
+
+    std::cout << "\nHeap usage by animation mode:\n";
+    printf("  %-34s %-6s %8s %12s %12s %12s %12s\n", "mode", "cost", "frames", "allocs/frame", "bytes/frame", "peak live", "retained");
+    for (size_t i = 0; i < modeMemory.size(); ++i) {
+      const ModeMemoryStats &mode = modeMemory[i];
+      if (mode.frames == 0) continue;
+      printf("  %-34s %-6s %8zu %12.1f %12s %12s %12s\n", generators[i].name, costClassNames[(int)generators[i].cost], mode.frames,
+             (double)mode.allocations / mode.frames,
+             formatBytes((double)mode.allocatedBytes / mode.frames).c_str(), formatBytes(mode.peakLiveBytes).c_str(),
+             formatBytes(mode.retainedBytes).c_str());
+    }
+    printf("  GPU buffers at exit: %s\n", formatBytes(gpuBuffers.total()).c_str());
+  }
+
+  // Returns false if a headless run ended with an OpenGL error
+  bool run() {
+    if (assertNoAlloc) return runAllocationCheck();
+    if (headlessFrames) return runHeadless();
+
     cout << "Mathematical Functions Animation with Mouse Camera Control\n";
     cout << "=========================================================\n";
     cout << "Mathematical Functions:\n";
-    cout << "1 - Parametric Spiral\n";
-    cout << "2 - Lissajous Curve\n";
-    cout << "3 - 3D Helix\n";
-    cout << "4 - Sine Wave Surface\n";
-    cout << "5 - Animated Torus\n";
-    cout << "6 - Hypotrochoid\n";
-    cout << "7 - Superformula\n";
-    cout << "8 - Lorenz Attractor\n";
-    cout << "9 - Klein Bottle\n";
-    cout << "0 - Gyroid Surface\n";
-    cout << "Q - Spherical Harmonic\n";
-    cout << "TAB - Fractal Zoom\n";
-    cout << "E - Phyllotaxis\n";
-    cout << "R - Tesseract 4D Projection\n";
-    cout << "T - Wave Interference Surface\n";
-    cout << "G - Gravitational Spacetime Curvature\n";
+    for (int mode = 0; mode < (int)generators.size(); ++mode) {
+      if (generators[mode].key == GLFW_KEY_UNKNOWN) continue;
+      cout << generators[mode].keyLabel << " - " << generators[mode].name << "\n";
+    }
     cout << "\nGravitational Controls:\n";
     cout << "+ - Increase central mass\n";
     cout << "- - Decrease central mass\n";
     cout << "Current mass: " << centralMass << "\n";
+    cout << "\nAttractor Controls:\n";
+    cout << "L - Cycle particle field (Lorenz/Rossler/Thomas/Aizawa)\n";
+    cout << "\nHypotrochoid Controls:\n";
+    cout << "[ / ] - Lower/raise the period denominator bound (max turns before closing)\n";
+    cout << "\nGPU Fractal Controls:\n";
+    cout << "H - Toggle flat view / heightmap terrain\n";
+    cout << "J - Toggle Mandelbrot / Julia set\n";
+    cout << "\nPlanar Controls (hypotrochoid, superformula, phyllotaxis):\n";
+    cout << "O - Toggle orthographic 2D view (no depth test) / perspective camera\n";
+    cout << "\nColormap Controls (helix, torus, Lorenz, Klein bottle, gyroid, spherical harmonic):\n";
+    cout << "Y - Cycle colormap (viridis/magma/inferno/plasma)\n";
+    cout << "\nLine Controls (curves and wireframes):\n";
+    cout << ", / . - Narrower/wider lines (pixels)\n";
+    cout << "I - Toggle round / miter joins\n";
+    cout << "\nPoint Controls (surfaces, gyroid, fractals, particles):\n";
+    cout << "; - Toggle additive / alpha blending of point sprites\n";
+    cout << "/ - Toggle chunk culling and distance LOD for the sine and wave surfaces\n";
+    cout << "\nPlugins (" << pluginDirectory() << ", reloaded when rebuilt):\n";
+    cout << "N - Cycle plugin generators\n";
     cout << "\nCamera Controls:\n";
     cout << "Mouse - Look around\n";
     cout << "W/A/S/D - Move forward/left/backward/right\n";
@@ -1267,86 +4296,496 @@ class MathAnimation {
     cout << "M - Toggle mouse cursor (enable/disable camera)\n";
     cout << "\nPerformance:\n";
     cout << "F1-F4 - Set FPS (30/60/120/144)\n";
-    cout << "F5-F8 - Set Quality (Low/Medium/High/Ultra)\n";
+    cout << "F5-F8 - Set Quality (Low/Medium/High/Ultra): 1/0.5/0.25/0.125 px error for curves and surfaces\n";
+    cout << "F9 - Toggle frame, memory and input-to-present latency telemetry\n";
+    cout << "F10 - Toggle keyframe interpolation (curves and surfaces generated " << keyframeRate << " times/s, blended per frame)\n";
     cout << "\nOther:\n";
     cout << "B - Change Background Color\n";
     cout << "V - Toggle VSync\n";
     cout << "K - Reset Camera Position\n";
     cout << "ESC - Exit\n\n";
     cout << "Camera speed: " << cameraSpeed << " (use mouse wheel to adjust)\n";
+    cout << "Generator kernels: " << SimdKernels::active->isa << " (override with --isa=)\n";
 
     while (!glfwWindowShouldClose(window)) {
       glfwPollEvents();
+      pollPlugins();
+      pollShaders();
+      render();
+      runDeferredStartupWork();
+    }
+    return true;
+  }
+
+  // Renders the start mode for headlessFrames frames. glFinish makes the total
+  // include the GPU work still queued after the last swap.
+  bool runHeadless() {
+    const GeneratorInfo &generator = generators[animationMode];
+    auto start = std::chrono::steady_clock::now();
+    int frame = 0;
+    for (; frame < headlessFrames && !glfwWindowShouldClose(window); ++frame) {
+      glfwPollEvents();
+      pollShaders();
       render();
+      runDeferredStartupWork();
+    }
+    glFinish();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Headless: " << frame << " frames of " << generator.name << " in " << std::fixed << std::setprecision(1) << ms << " ms ("
+              << std::setprecision(2) << ms / std::max(1, frame) << " ms/frame) on " << glGetString(GL_RENDERER) << std::defaultfloat << "\n";
+
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+      std::cerr << "OpenGL error 0x" << std::hex << error << std::dec << "\n";
+      return false;
+    }
+    return true;
+  }
+
+  // Steps every built-in mode at each quality level past warm-up, then counts heap
+  // allocations in each of the next headlessFrames frames. Any allocation fails the
+  // check. Plugins are not loaded, so only the host's own generators are covered.
+  bool runAllocationCheck() {
+    if (!AllocTelemetry::enabled) {
+      std::cerr << "--assert-no-alloc needs the heap counters; build with make TELEMETRY=1\n";
+      return false;
+    }
+
+    if (!buildShaderPrograms(shaderProgramCount)) return false;  // Up front, so no mode's first frames build them
+
+    const int warmupFrames = 30;
+    int failures = 0;
+    printf("Allocation check, most heap allocations in a frame (%d frames after %d warm-up frames)\n", headlessFrames, warmupFrames);
+    printf("  %-34s %9s %9s %9s %9s\n", "mode", "Low", "Medium", "High", "Ultra");
+    for (int mode = 0; mode < builtinGeneratorCount && !glfwWindowShouldClose(window); ++mode) {
+      selectMode(mode);
+      printf("  %-34s", generators[mode].name);
+      for (int level = 0; level < 4; ++level) {
+        waitForGeneration();
+        qualityLevel = level;
+        presizeForMode();
+
+        size_t worst = 0;
+        for (int frame = 0; frame < warmupFrames + headlessFrames; ++frame) {
+          size_t before = AllocTelemetry::allocations.load(std::memory_order_relaxed);
+          glfwPollEvents();
+          pollShaders();
+          render();
+          waitForGeneration();  // Every frame includes the whole job it started
+          if (frame >= warmupFrames) worst = std::max(worst, AllocTelemetry::allocations.load(std::memory_order_relaxed) - before);
+        }
+        if (worst > 0) failures++;
+        printf(" %9zu", worst);
+      }
+      printf("\n");
     }
+    waitForGeneration();
+
+    if (failures) {
+      std::cerr << "Allocation check failed: " << failures << " mode and quality combinations allocated in steady state\n";
+      return false;
+    }
+    std::cout << "Allocation check passed\n";
+
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+      std::cerr << "OpenGL error 0x" << std::hex << error << std::dec << "\n";
+      return false;
+    }
+    return true;
   }
 
   void cleanup() {
+    waitForGeneration();
+    printModeMemoryReport();
+
     glDeleteVertexArrays(1, &VAO);
+    glDeleteVertexArrays(1, &planarVAO);
+    glDeleteVertexArrays(1, &scalarVAO);
+    glDeleteVertexArrays(1, &polylineVAO);
+    glDeleteTextures(1, &polylineTexture);
+    glDeleteTextures(1, &keyframeTexture);
+    if (scalarColormap) glDeleteTextures(1, &scalarColormap);
+    gpuBuffers.release(VBO);
     glDeleteBuffers(1, &VBO);
+    gpuBuffers.release(keyframeVBO);
+    glDeleteBuffers(1, &keyframeVBO);
+    if (stripIndexBuffer) {
+      gpuBuffers.release(stripIndexBuffer);
+      glDeleteBuffers(1, &stripIndexBuffer);
+    }
+    for (HeightfieldMesh *mesh : {&sineSurfaceMesh, &waveInterferenceMesh, &spacetimeMesh}) {
+      if (!mesh->vao) continue;
+      glDeleteVertexArrays(1, &mesh->vao);
+      gpuBuffers.release(mesh->vbo);
+      glDeleteBuffers(1, &mesh->vbo);
+    }
     glDeleteProgram(shaderProgram);
+    glDeleteProgram(planarProgram);
+    glDeleteProgram(scalarProgram);
+    glDeleteProgram(polylineProgram);
+    glDeleteProgram(pointProgram);
+    glDeleteProgram(sineSurfaceProgram);
+    glDeleteProgram(waveInterferenceProgram);
+    glDeleteProgram(spacetimeProgram);
+    for (HeightStream *stream : {&fractalStream, &deepZoomStream}) {
+      if (!stream->vao) continue;
+      glDeleteVertexArrays(1, &stream->vao);
+      gpuBuffers.release(stream->buffer);
+      glDeleteBuffers(1, &stream->buffer);
+      glDeleteTextures(1, &stream->texture);
+      glDeleteTextures(1, &stream->colormap);
+    }
+    glDeleteProgram(heightStreamProgram);
+    if (gpuFractal.vao) glDeleteVertexArrays(1, &gpuFractal.vao);
+    if (gpuFractal.framebuffer) {
+      glDeleteFramebuffers(1, &gpuFractal.framebuffer);
+      glDeleteTextures(1, &gpuFractal.heightMap);
+    }
+    if (gpuFractal.colormap) glDeleteTextures(1, &gpuFractal.colormap);
+    glDeleteProgram(fractalProgram);
+    glDeleteProgram(fractalTerrainProgram);
+    if (particles.vao[0]) {
+      glDeleteVertexArrays(2, particles.vao);
+      gpuBuffers.release(particles.vbo[0]);
+      gpuBuffers.release(particles.vbo[1]);
+      glDeleteBuffers(2, particles.vbo);
+    }
+    glDeleteProgram(particleUpdateProgram);
+    glDeleteProgram(particleProgram);
+    if (pluginLoader.joinable()) pluginLoader.join();
+    pluginHost.unloadAll();
     glfwTerminate();
   }
 
  private:
-  bool createShaderProgram() {
-    // Compile vertex shader
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
+  // Compiles one shader stage; returns 0 and logs the error on failure
+  GLuint compileShader(GLenum type, const char *source, const char *label) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
 
     // Check compilation
     GLint success;
     GLchar infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
     if (!success) {
-      glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-      std::cerr << "Vertex shader compilation failed: " << infoLog << "\n";
-      return false;
+      glGetShaderInfoLog(shader, 512, NULL, infoLog);
+      std::cerr << label << ": " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader compilation failed: " << infoLog << "\n";
+      glDeleteShader(shader);
+      return 0;
     }
+    return shader;
+  }
 
-    // Compile fragment shader
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-      glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-      std::cerr << "Fragment shader compilation failed: " << infoLog << "\n";
-      return false;
+  // Compiles and links one program; returns 0 and logs the error on failure. A
+  // NULL fragment source builds a vertex-only program, and feedback varyings are
+  // captured interleaved for transform feedback.
+  GLuint compileProgram(const char *vertexSource, const char *fragmentSource, const char *label, const char *const *feedbackVaryings = NULL,
+                        int feedbackVaryingCount = 0) {
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource, label);
+    if (!vertexShader) return 0;
+
+    GLuint fragmentShader = 0;
+    if (fragmentSource) {
+      fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource, label);
+      if (!fragmentShader) {
+        glDeleteShader(vertexShader);
+        return 0;
+      }
     }
 
     // Create shader program
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    if (fragmentShader) glAttachShader(program, fragmentShader);
+    if (feedbackVaryingCount > 0) glTransformFeedbackVaryings(program, feedbackVaryingCount, feedbackVaryings, GL_INTERLEAVED_ATTRIBS);
+    if (programCache.enabled()) glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(program);
 
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+    glDeleteShader(vertexShader);
+    if (fragmentShader) glDeleteShader(fragmentShader);
+
+    GLint success;
+    GLchar infoLog[512];
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
     if (!success) {
-      glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-      std::cerr << "Shader program linking failed: " << infoLog << "\n";
-      return false;
+      glGetProgramInfoLog(program, 512, NULL, infoLog);
+      std::cerr << label << ": shader program linking failed: " << infoLog << "\n";
+      glDeleteProgram(program);
+      return 0;
     }
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    return program;
+  }
+
+  // Shader and binary cache directories, overridable with MANIM_SHADER_DIR and MANIM_SHADER_CACHE
+  static std::string shaderDirectory() {
+    const char *dir = getenv("MANIM_SHADER_DIR");
+    return dir ? dir : "shaders";
+  }
+
+  static std::string shaderCacheDirectory() {
+    const char *dir = getenv("MANIM_SHADER_CACHE");
+    return dir ? dir : "shader_cache";
+  }
 
+  static bool readShaderFile(const char *file, std::string &source) {
+    std::ifstream in(std::filesystem::path(shaderDirectory()) / file, std::ios::binary);
+    if (!in) {
+      std::cerr << "Failed to read shader file " << shaderDirectory() << "/" << file << "\n";
+      return false;
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    source = contents.str();
     return true;
   }
+
+  // Builds one program from its shader files, loading the linked binary from the
+  // cache when the sources and driver match; returns 0 on failure
+  GLuint buildProgram(const ShaderProgramInfo &info) {
+    std::string vertexSource, fragmentSource;
+    if (!readShaderFile(info.vertexFile, vertexSource)) return 0;
+    if (info.fragmentFile && !readShaderFile(info.fragmentFile, fragmentSource)) return 0;
+
+    std::string cacheName = std::filesystem::path(info.vertexFile).stem().string();
+    uint64_t key = programCache.key(vertexSource + '\0' + fragmentSource + '\0' + (info.feedbackVarying ? info.feedbackVarying : ""));
+    GLuint program = programCache.load(cacheName, key);
+    if (program) return program;
+
+    program = compileProgram(vertexSource.c_str(), info.fragmentFile ? fragmentSource.c_str() : NULL, info.label,
+                             info.feedbackVarying ? &info.feedbackVarying : NULL, info.feedbackVarying ? 1 : 0);
+    if (program) programCache.store(cacheName, key, program);
+    return program;
+  }
+
+  // Builds programs in table order until `count` exist; returns false if one failed.
+  // The cold/warm report is printed once the last program is built.
+  bool buildShaderPrograms(int count) {
+    if (programsBuilt >= count) return true;
+    auto start = std::chrono::steady_clock::now();
+    bool success = true;
+    for (; programsBuilt < count; ++programsBuilt) {
+      const ShaderProgramInfo &info = shaderPrograms[shaderBuildOrder[programsBuilt]];
+      GLuint program = buildProgram(info);
+      this->*info.program = program;
+      success &= program != 0;
+    }
+    shaderBuildMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (programsBuilt < shaderProgramCount) return success;
+
+    // Cold starts compile everything; warm starts load every program from the cache
+    size_t cached = programCache.hitCount();
+    std::cout << "Shaders: " << shaderProgramCount << " programs in " << std::fixed << std::setprecision(1) << shaderBuildMs << " ms"
+              << std::defaultfloat;
+    if (!programCache.enabled()) {
+      std::cout << " (program binaries not supported by the driver)\n";
+    } else if (cached >= (size_t)shaderProgramCount) {
+      std::cout << " (warm start: all from binary cache)\n";
+    } else if (cached == 0) {
+      std::cout << " (cold start: all compiled)\n";
+    } else {
+      std::cout << " (" << cached << " from binary cache, " << shaderProgramCount - cached << " compiled)\n";
+    }
+    return success;
+  }
+
+  // Only the programs that are not deferred are needed for the first frame of a CPU-vertex mode
+  bool createShaderProgram() {
+    int firstFrameCount = 0;
+    for (int i = 0; i < shaderProgramCount; ++i) firstFrameCount += !shaderPrograms[i].deferred;
+    return buildShaderPrograms(firstFrameCount);
+  }
+
+  // GPU paths use the programs deferred past the first frame; build them now if
+  // the user gets there first
+  bool ensureProgramsFor(const GeneratorInfo &generator) {
+    if (generatesVertices(generator)) return true;
+    return buildShaderPrograms(shaderProgramCount);
+  }
+
+  // Work kept off the path to the first frame: reports the startup profile, starts
+  // the plugin scan, then builds one deferred shader program per frame
+  void runDeferredStartupWork() {
+    if (!startup.reported) {
+      startup.mark("first frame");
+      startup.report();
+      startPluginLoader();
+      return;
+    }
+    if (programsBuilt < shaderProgramCount) buildShaderPrograms(programsBuilt + 1);
+  }
+
+  // Relinks programs whose shader files changed. A program that fails to build
+  // keeps running its previous version.
+  void pollShaders() {
+    changedShaderFiles.clear();
+    if (!shaderWatcher.poll(changedShaderFiles)) return;
+
+    for (int i = 0; i < programsBuilt; ++i) {
+      const ShaderProgramInfo &info = shaderPrograms[shaderBuildOrder[i]];
+      bool affected = false;
+      for (const std::string &file : changedShaderFiles) {
+        affected |= file == info.vertexFile || (info.fragmentFile && file == info.fragmentFile);
+      }
+      if (!affected) continue;
+
+      GLuint program = buildProgram(info);
+      if (!program) {
+        std::cerr << info.label << ": keeping the previous program\n";
+        continue;
+      }
+      glDeleteProgram(this->*info.program);
+      this->*info.program = program;
+      std::cout << "Reloaded shader program: " << info.label << "\n";
+    }
+  }
+};
+
+// Programs for the CPU-vertex paths are built before the first frame; the GPU-path ones are deferred
+const MathAnimation::ShaderProgramInfo MathAnimation::shaderPrograms[] = {
+    {"Default", "default.vert", "default.frag", NULL, &MathAnimation::shaderProgram, false},
+    {"Planar", "planar.vert", "default.frag", NULL, &MathAnimation::planarProgram, false},
+    {"Scalar", "scalar.vert", "scalar.frag", NULL, &MathAnimation::scalarProgram, false},
+    {"Polyline", "polyline.vert", "polyline.frag", NULL, &MathAnimation::polylineProgram, false},
+    {"Points", "points.vert", "point_sprite.frag", NULL, &MathAnimation::pointProgram, false},
+    {"Sine surface", "sine_surface.vert", "point_sprite.frag", NULL, &MathAnimation::sineSurfaceProgram, true},
+    {"Wave interference", "wave_interference.vert", "point_sprite.frag", NULL, &MathAnimation::waveInterferenceProgram, true},
+    {"Spacetime", "spacetime.vert", "default.frag", NULL, &MathAnimation::spacetimeProgram, true},
+    {"Height stream", "height_stream.vert", "point_sprite.frag", NULL, &MathAnimation::heightStreamProgram, true},
+    {"Particle update", "particle_update.vert", NULL, "outState", &MathAnimation::particleUpdateProgram, true},
+    {"Particles", "particles.vert", "point_sprite.frag", NULL, &MathAnimation::particleProgram, true},
+    {"Fractal", "fullscreen.vert", "fractal.frag", NULL, &MathAnimation::fractalProgram, true},
+    {"Fractal terrain", "fractal_terrain.vert", "point_sprite.frag", NULL, &MathAnimation::fractalTerrainProgram, true},
 };
 
-int main() {
+const int MathAnimation::shaderProgramCount = sizeof(MathAnimation::shaderPrograms) / sizeof(MathAnimation::shaderPrograms[0]);
+
+// Tessellation-specialized surface generators, indexed by level (1/4x to 8x the base segments)
+const MathAnimation::GenerateFn MathAnimation::torusKernels[] = {
+    &MathAnimation::generateTorus<TessellationPolicy<1>>,  &MathAnimation::generateTorus<TessellationPolicy<2>>,
+    &MathAnimation::generateTorus<TessellationPolicy<4>>,  &MathAnimation::generateTorus<TessellationPolicy<8>>,
+    &MathAnimation::generateTorus<TessellationPolicy<16>>, &MathAnimation::generateTorus<TessellationPolicy<32>>};
+const MathAnimation::GenerateFn MathAnimation::kleinBottleKernels[] = {
+    &MathAnimation::generateKleinBottle<TessellationPolicy<1>>,  &MathAnimation::generateKleinBottle<TessellationPolicy<2>>,
+    &MathAnimation::generateKleinBottle<TessellationPolicy<4>>,  &MathAnimation::generateKleinBottle<TessellationPolicy<8>>,
+    &MathAnimation::generateKleinBottle<TessellationPolicy<16>>, &MathAnimation::generateKleinBottle<TessellationPolicy<32>>};
+const MathAnimation::GenerateFn MathAnimation::sphericalHarmonicKernels[] = {
+    &MathAnimation::generateSphericalHarmonic<TessellationPolicy<1>>,  &MathAnimation::generateSphericalHarmonic<TessellationPolicy<2>>,
+    &MathAnimation::generateSphericalHarmonic<TessellationPolicy<4>>,  &MathAnimation::generateSphericalHarmonic<TessellationPolicy<8>>,
+    &MathAnimation::generateSphericalHarmonic<TessellationPolicy<16>>, &MathAnimation::generateSphericalHarmonic<TessellationPolicy<32>>};
+
+// Chord errors at level 0: the largest distance between an edge midpoint and the
+// surface over the animation, rounded up (torus 0.039, Klein bottle 0.041,
+// spherical harmonic 0.072, dominated by its l theta ripple)
+const MathAnimation::SurfaceLod MathAnimation::torusLod = {MathAnimation::torusKernels, 1.8f, 0.04f};
+const MathAnimation::SurfaceLod MathAnimation::kleinBottleLod = {MathAnimation::kleinBottleKernels, 1.0f, 0.045f};
+const MathAnimation::SurfaceLod MathAnimation::sphericalHarmonicLod = {MathAnimation::sphericalHarmonicKernels, 1.5f, 0.075f};
+
+const MathAnimation::GeneratorInfo MathAnimation::builtinGenerators[] = {
+    // Numbers 1-9, 0
+    {"Parametric Spiral", GLFW_KEY_1, "1", DrawPath::CpuVertices, GL_LINE_STRIP, true, true, CostClass::Light, &MathAnimation::countParametricSpiral,
+     &MathAnimation::generateParametricSpiral, NULL, NULL, NULL, NULL, 0, NULL, 0.0f, 0},
+    {"Lissajous Curve", GLFW_KEY_2, "2", DrawPath::CpuVertices, GL_LINE_STRIP, true, true, CostClass::Light, &MathAnimation::countLissajous,
+     &MathAnimation::generateLissajous, NULL, NULL, NULL, NULL, 0, NULL, 0.0f, 0},
+    {"3D Helix", GLFW_KEY_3, "3", DrawPath::CpuScalar, GL_LINE_STRIP, true, true, CostClass::Light, &MathAnimation::count3DHelix,
+     &MathAnimation::generate3DHelix, NULL, NULL, NULL, NULL, 0, NULL, 0.0f, 0},
+    {"Sine Wave Surface", GLFW_KEY_4, "4", DrawPath::GpuHeightfield, GL_POINTS, true, false, CostClass::Free, &MathAnimation::countSineWaveSurface,
+     &MathAnimation::buildSineWaveGrid, &MathAnimation::sineSurfaceProgram, &MathAnimation::setSineSurfaceUniforms, &MathAnimation::sineSurfaceMesh,
+     NULL, 0, NULL, 3.0f, 2},
+    {"Animated Torus", GLFW_KEY_5, "5", DrawPath::CpuScalar, GL_LINE_STRIP, true, true, CostClass::Heavy, &MathAnimation::countTorus,
+     NULL, NULL, NULL, NULL, NULL, 0, &MathAnimation::torusLod, 0.0f, 0},
+    {"Hypotrochoid", GLFW_KEY_6, "6", DrawPath::CpuPlanar, GL_LINE_STRIP, true, false, CostClass::Light, &MathAnimation::countHypotrochoid,
+     &MathAnimation::generateHypotrochoid, NULL, NULL, NULL, NULL, 0, NULL, 0.0f, 0},
+    {"Superformula", GLFW_KEY_7, "7", DrawPath::CpuPlanar, GL_LINE_STRIP, true, false, CostClass::Light, &MathAnimation::countSuperformula,
+     &MathAnimation::generateSuperformula, NULL, NULL, NULL, NULL, 0, NULL, 0.0f, 0},
+    {"Lorenz Attractor", GLFW_KEY_8, "8", DrawPath::CpuScalar, GL_LINE_STRIP, true, false, CostClass::Light, &MathAnimation::countLorenzAttractor,
+     &MathAnimation::generateLorenzAttractor, NULL, NULL, NULL, NULL, 0, NULL, 0.0f, 0},
+    {"Klein Bottle", GLFW_KEY_9, "9", DrawPath::CpuScalar, GL_LINE_STRIP, true, true, CostClass::Heavy, &MathAnimation::countKleinBottle,
+     NULL, NULL, NULL, NULL, NULL, 0, &MathAnimation::kleinBottleLod, 0.0f, 0},
+    {"Gyroid Surface", GLFW_KEY_0, "0", DrawPath::CpuScalar, GL_POINTS, true, false, CostClass::Heavy, &MathAnimation::countGyroid,
+     &MathAnimation::generateGyroid, NULL, NULL, NULL, NULL, 0, NULL, 4.0f, 3},
+
+    // Letters (TAB instead of W for the fractal to avoid the movement keys)
+    {"Spherical Harmonic", GLFW_KEY_Q, "Q", DrawPath::CpuScalar, GL_LINE_STRIP, true, true, CostClass::Heavy, &MathAnimation::countSphericalHarmonic,
+     NULL, NULL, NULL, NULL, NULL, 0, &MathAnimation::sphericalHarmonicLod, 0.0f, 0},
+    {"Fractal Zoom", GLFW_KEY_TAB, "TAB", DrawPath::HeightStream, GL_POINTS, true, false, CostClass::Heavy, &MathAnimation::countFractalZoom,
+     &MathAnimation::generateFractalZoom, &MathAnimation::heightStreamProgram, NULL, NULL, &MathAnimation::fractalStream, 0, NULL, 1.0f, 2},
+    {"Deep Zoom Fractal (perturbation)", GLFW_KEY_Z, "Z", DrawPath::HeightStream, GL_POINTS, true, false, CostClass::Heavy,
+     &MathAnimation::countFractalZoom, &MathAnimation::generateDeepZoom, &MathAnimation::heightStreamProgram, NULL, NULL,
+     &MathAnimation::deepZoomStream, 0, NULL, 1.0f, 2},
+    {"Phyllotaxis", GLFW_KEY_E, "E", DrawPath::CpuPlanar, GL_LINE_STRIP, true, true, CostClass::Light, &MathAnimation::countPhyllotaxis,
+     &MathAnimation::generatePhyllotaxis, NULL, NULL, NULL, NULL, 0, NULL, 0.0f, 0},
+    {"Tesseract 4D Projection", GLFW_KEY_R, "R", DrawPath::CpuVertices, GL_LINE_STRIP, true, true, CostClass::Light, &MathAnimation::countTesseract4D,
+     &MathAnimation::generateTesseract4D, NULL, NULL, NULL, NULL, 0, NULL, 0.0f, 0},
+    {"Wave Interference Surface", GLFW_KEY_T, "T", DrawPath::GpuHeightfield, GL_POINTS, true, false, CostClass::Free,
+     &MathAnimation::countWaveInterference, &MathAnimation::buildWaveInterferenceGrid, &MathAnimation::waveInterferenceProgram,
+     &MathAnimation::setWaveInterferenceUniforms, &MathAnimation::waveInterferenceMesh, NULL, 0, NULL, 4.0f, 2},
+    {"Gravitational Spacetime Curvature", GLFW_KEY_G, "G", DrawPath::GpuHeightfield, GL_LINE_STRIP, false, false, CostClass::Free,
+     &MathAnimation::countGravitationalSpacetime, &MathAnimation::buildGravitationalSpacetimeGrid, &MathAnimation::spacetimeProgram,
+     &MathAnimation::setSpacetimeUniforms, &MathAnimation::spacetimeMesh, NULL, 0, NULL, 0.0f, 0},
+    {"Attractor Particles (GPU)", GLFW_KEY_P, "P", DrawPath::GpuParticles, GL_POINTS, true, false, CostClass::Free,
+     &MathAnimation::countAttractorParticles, NULL, &MathAnimation::particleProgram, NULL, NULL, NULL, 0, NULL, 2.0f, 2},
+    {"Lorenz Ensemble", GLFW_KEY_X, "X", DrawPath::CpuVertices, GL_LINE_STRIP, true, true, CostClass::Heavy, &MathAnimation::countLorenzEnsemble,
+     &MathAnimation::generateLorenzEnsemble, NULL, NULL, NULL, NULL, (size_t)MathAnimation::lorenzEnsembleLength, NULL, 0.0f, 0},
+    {"Fractal Zoom (GPU shader)", GLFW_KEY_U, "U", DrawPath::GpuFractal, GL_POINTS, true, false, CostClass::Free, &MathAnimation::countGpuFractal,
+     NULL, &MathAnimation::fractalProgram, NULL, NULL, NULL, 0, NULL, 1.0f, 2},
+};
+
+const int MathAnimation::builtinGeneratorCount = sizeof(MathAnimation::builtinGenerators) / sizeof(MathAnimation::builtinGenerators[0]);
+
+// Options:
+//   --headless[=N]  render N frames (default 300) into a hidden window, print the timing and exit
+//   --assert-no-alloc  with --headless, render N frames of every mode at each quality level after warm-up and
+//                      exit non-zero if any of them allocated on the heap (needs make TELEMETRY=1)
+//   --mode=KEY      start in the mode selected by KEY, as labeled in the mode list (e.g. U, TAB)
+//   --bench[=N]     time CPU generation of every mode at each quality level (best of N, default 20) and exit
+//   --isa=NAME      use the baseline, sse4.2, avx2 or avx512 generator kernels instead of the widest the CPU supports
+//   --keyframes[=N] generate curves and parametric surfaces N times a second (default 30) and blend in between
+int main(int argc, char **argv) {
   MathAnimation app;
+  const char *isa = NULL;
+  int benchRepetitions = 0;
+  bool assertNoAlloc = false;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--bench", 7) == 0 && (argv[i][7] == '\0' || argv[i][7] == '=')) {
+      benchRepetitions = std::max(1, argv[i][7] == '=' ? atoi(argv[i] + 8) : 20);
+    } else if (strncmp(argv[i], "--isa=", 6) == 0) {
+      isa = argv[i] + 6;
+    } else if (strncmp(argv[i], "--headless", 10) == 0 && (argv[i][10] == '\0' || argv[i][10] == '=')) {
+      app.setHeadless(argv[i][10] == '=' ? atoi(argv[i] + 11) : 300);
+    } else if (strcmp(argv[i], "--assert-no-alloc") == 0) {
+      assertNoAlloc = true;
+    } else if (strncmp(argv[i], "--keyframes", 11) == 0 && (argv[i][11] == '\0' || argv[i][11] == '=')) {
+      app.setKeyframes(argv[i][11] == '=' ? atof(argv[i] + 12) : 30.0);
+    } else if (strncmp(argv[i], "--mode=", 7) == 0) {
+      if (!app.setStartMode(argv[i] + 7)) {
+        std::cerr << "Unknown mode key: " << argv[i] + 7 << "\n";
+        return -1;
+      }
+    } else {
+      std::cerr << "Unknown option: " << argv[i] << "\n";
+      return -1;
+    }
+  }
+
+  if (!SimdKernels::select(isa)) return -1;
+  if (assertNoAlloc) app.setAssertNoAlloc();
+  if (benchRepetitions) {
+    app.runBenchmark(benchRepetitions);
+    return 0;
+  }
 
   if (!app.initialize()) {
     std::cerr << "Failed to initialize application" << "\n";
     return -1;
   }
 
-  app.run();
+  bool ok = app.run();
   app.cleanup();
 
-  return 0;
+  return ok ? 0 : 1;
 }
@@ -0,0 +1,36 @@
+// Example generator plugin: an animated rose curve r = cos(k * theta).
+// Build with `make plugins`; edits are picked up by the running application.
+#include <math.h>
+
+#include "generator_plugin.h"
+
+static size_t roseMaxVertices(int qualityMult) { return 2000 * (size_t)qualityMult; }
+
+static size_t roseGenerate(float *out, size_t capacity, float t, int qualityMult) {
+  size_t numPoints = roseMaxVertices(qualityMult);
+  if (numPoints > capacity) numPoints = capacity;
+
+  // k drifts between 2 and 3; four turns keep the petals closed at k = 2.5
+  const float k = 2.5f + 0.5f * sinf(t * 0.4f);
+  const float span = 8.0f * 3.14159265f;
+
+  for (size_t i = 0; i < numPoints; ++i) {
+    float theta = (float)i / numPoints * span;
+    float r = cosf(k * theta) * (0.9f + 0.1f * sinf(t + theta * 0.25f));
+
+    out[0] = r * cosf(theta);
+    out[1] = r * sinf(theta);
+    out[2] = 0.15f * sinf(theta * 0.5f + t);
+    out[3] = 0.6f + 0.4f * sinf(theta + t);
+    out[4] = 0.4f + 0.4f * fabsf(r);
+    out[5] = 0.8f - 0.3f * fabsf(r);
+    out += 6;
+  }
+  return numPoints;
+}
+
+static const ManimGeneratorPlugin rosePlugin = {
+    MANIM_PLUGIN_ABI_VERSION, "Rose Curve (plugin)", MANIM_PRIMITIVE_LINE_STRIP, 1, roseMaxVertices, roseGenerate,
+};
+
+MANIM_PLUGIN_EXPORT const ManimGeneratorPlugin *manim_generator_plugin(void) { return &rosePlugin; }
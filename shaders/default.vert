@@ -0,0 +1,23 @@
+#version 330 core
+
+// Pass-through shader for CPU-generated interleaved position/color vertices. With
+// keyframe interpolation on, locations 2 and 3 hold the same vertex in the other
+// keyframe and uKeyframeMix is its weight.
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec3 aNextPos;
+layout (location = 3) in vec3 aNextColor;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform float uKeyframeMix;
+
+out vec3 FragColor;
+
+void main()
+{
+    gl_Position = projection * view * model * vec4(mix(aPos, aNextPos, uKeyframeMix), 1.0);
+    FragColor = mix(aColor, aNextColor, uKeyframeMix);
+}
@@ -0,0 +1,45 @@
+#version 330 core
+
+// Escape-time Mandelbrot or Julia set evaluated per fragment. The color output
+// uses the smooth (continuous) escape count; with uOutputHeight set it instead
+// writes that count normalized to [0, 1], with interior points at 1, into an
+// R32F heightmap whose texel (i, j) is the CPU fractal grid's cell (i, j).
+
+uniform vec2 uViewport;  // Target size in pixels
+uniform float uZoom;     // Width of the view in the complex plane
+uniform vec2 uCenter;
+uniform int uMaxIterations;
+uniform bool uJulia;
+uniform vec2 uJuliaC;
+uniform bool uOutputHeight;
+
+out vec4 color;
+
+void main()
+{
+    // Heightmap texels sample the CPU grid's corners; screen pixels keep square aspect
+    vec2 p = uOutputHeight ? (gl_FragCoord.xy - 0.5) / uViewport - 0.5 : (gl_FragCoord.xy - 0.5 * uViewport) / uViewport.y;
+    vec2 c = uCenter + p * uZoom;
+
+    vec2 z = uJulia ? c : vec2(0.0);
+    vec2 k = uJulia ? uJuliaC : c;
+    int iter = 0;
+    // A bailout radius of 16 keeps the smooth count free of banding
+    while (iter < uMaxIterations && dot(z, z) < 256.0) {
+        z = vec2(z.x * z.x - z.y * z.y, 2.0 * z.x * z.y) + k;
+        ++iter;
+    }
+
+    if (iter >= uMaxIterations) {
+        color = uOutputHeight ? vec4(1.0) : vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
+    // n + 1 - log2(log2 |z|), continuous across escape-count bands
+    float mu = max(float(iter) + 1.0 - log2(0.5 * log2(dot(z, z))), 0.0);
+    if (uOutputHeight) {
+        color = vec4(min(mu / float(uMaxIterations), 1.0));
+    } else {
+        color = vec4(0.5 + 0.5 * cos(3.0 + 0.15 * mu + vec3(0.0, 0.6, 1.0)), 1.0);
+    }
+}
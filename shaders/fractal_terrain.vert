@@ -0,0 +1,33 @@
+#version 330 core
+
+// Point grid displaced by the fractal heightmap rendered on the GPU. Cells are
+// placed like the CPU fractal stream: cell (i, j) at (i / res - 0.5, h - 0.5,
+// j / res - 0.5), colored from a 1D colormap indexed by height.
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform sampler2D uHeightMap;
+uniform sampler1D uColormap;
+uniform int uGridResolution;
+uniform float uPointSpacing;   // World-space distance the sprite covers
+uniform float uPixelsPerUnit;  // Pixels per world unit at unit depth
+
+out vec3 FragColor;
+out float PointSize;
+
+void main()
+{
+    int i = gl_VertexID / uGridResolution;
+    int j = gl_VertexID - i * uGridResolution;
+    float h = texelFetch(uHeightMap, ivec2(i, j), 0).r;
+
+    float x = float(i) / float(uGridResolution) - 0.5;
+    float z = float(j) / float(uGridResolution) - 0.5;
+
+    float stops = float(textureSize(uColormap, 0));
+    FragColor = texture(uColormap, (clamp(h, 0.0, 1.0) * (stops - 1.0) + 0.5) / stops).rgb;
+    gl_Position = projection * view * model * vec4(x, h - 0.5, z, 1.0);
+    PointSize = uPointSpacing * uPixelsPerUnit / gl_Position.w;
+    gl_PointSize = clamp(PointSize, 1.0, 32.0);
+}
@@ -0,0 +1,10 @@
+#version 330 core
+
+// Attribute-less full-screen triangle: vertices 0, 1, 2 land on (-1, -1),
+// (3, -1) and (-1, 3), which covers the viewport without a vertex buffer.
+
+void main()
+{
+    vec2 p = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+}
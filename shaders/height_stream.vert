@@ -0,0 +1,39 @@
+#version 330 core
+
+// Vertex-pulling heightfield for grids that stay CPU-computed. Only one float per
+// cell is streamed (through a texture buffer); x/z are rebuilt from gl_VertexID
+// and color comes from a 1D colormap indexed by normalized height.
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform samplerBuffer uHeights;
+uniform sampler1D uColormap;
+uniform int uGridResolution;
+uniform vec2 uGridOrigin;
+uniform vec2 uGridSpacing;
+uniform float uHeightScale;
+uniform float uHeightOffset;
+uniform float uPointSpacing;   // World-space distance the sprite covers
+uniform float uPixelsPerUnit;  // Pixels per world unit at unit depth
+
+out vec3 FragColor;
+out float PointSize;
+
+void main()
+{
+    int i = gl_VertexID / uGridResolution;
+    int j = gl_VertexID - i * uGridResolution;
+    float h = texelFetch(uHeights, gl_VertexID).r;
+
+    float x = uGridOrigin.x + float(i) * uGridSpacing.x;
+    float z = uGridOrigin.y + float(j) * uGridSpacing.y;
+    float y = h * uHeightScale + uHeightOffset;
+
+    // Sample at texel centers so h = 0 and h = 1 land exactly on the end stops
+    float stops = float(textureSize(uColormap, 0));
+    FragColor = texture(uColormap, (clamp(h, 0.0, 1.0) * (stops - 1.0) + 0.5) / stops).rgb;
+    gl_Position = projection * view * model * vec4(x, y, z, 1.0);
+    PointSize = uPointSpacing * uPixelsPerUnit / gl_Position.w;
+    gl_PointSize = clamp(PointSize, 1.0, 32.0);
+}
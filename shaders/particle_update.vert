@@ -0,0 +1,68 @@
+#version 330 core
+
+// Particle engine update pass. Each particle state (xyz position, w speed) is
+// advanced with RK4 through the selected vector field and captured by transform
+// feedback into the other state buffer; nothing is rasterized.
+
+layout (location = 0) in vec4 aState;
+
+uniform int uField;  // 0 Lorenz, 1 Rossler, 2 Thomas, 3 Aizawa
+uniform float uParams[6];
+uniform float uDt;
+uniform int uSubsteps;
+uniform float uBound;
+uniform vec3 uSeedCenter;
+uniform float uSeedExtent;
+uniform uint uSeed;
+uniform bool uReseed;
+
+out vec4 outState;
+
+vec3 field(vec3 p)
+{
+    if (uField == 0) {
+        return vec3(uParams[0] * (p.y - p.x), p.x * (uParams[1] - p.z) - p.y, p.x * p.y - uParams[2] * p.z);
+    } else if (uField == 1) {
+        return vec3(-p.y - p.z, p.x + uParams[0] * p.y, uParams[1] + p.z * (p.x - uParams[2]));
+    } else if (uField == 2) {
+        return vec3(sin(p.y) - uParams[0] * p.x, sin(p.z) - uParams[0] * p.y, sin(p.x) - uParams[0] * p.z);
+    }
+    float zb = p.z - uParams[1];
+    return vec3(zb * p.x - uParams[3] * p.y,
+                uParams[3] * p.x + zb * p.y,
+                uParams[2] + uParams[0] * p.z - p.z * p.z * p.z / 3.0 - (p.x * p.x + p.y * p.y) * (1.0 + uParams[4] * p.z) +
+                    uParams[5] * p.z * p.x * p.x * p.x);
+}
+
+uint hash(uint x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+vec3 spawn()
+{
+    uint n = uint(gl_VertexID) * 3u + uSeed * 0x9e3779b9u;
+    vec3 r = vec3(hash(n), hash(n + 1u), hash(n + 2u)) / 4294967295.0;
+    return uSeedCenter + (r * 2.0 - 1.0) * uSeedExtent;
+}
+
+void main()
+{
+    vec3 p = uReseed ? spawn() : aState.xyz;
+    for (int s = 0; s < uSubsteps; ++s) {
+        vec3 k1 = field(p);
+        vec3 k2 = field(p + 0.5 * uDt * k1);
+        vec3 k3 = field(p + 0.5 * uDt * k2);
+        vec3 k4 = field(p + uDt * k3);
+        p += uDt / 6.0 * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
+    }
+
+    // Respawn particles that diverged
+    if (any(isnan(p)) || dot(p - uSeedCenter, p - uSeedCenter) > uBound * uBound) p = spawn();
+    outState = vec4(p, length(field(p)));
+}
@@ -0,0 +1,28 @@
+#version 330 core
+
+// Draws particle states straight from the feedback buffer, colored by speed
+// the same way as the single Lorenz trajectory
+
+layout (location = 0) in vec4 aState;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 uScale;
+uniform vec3 uOffset;
+uniform float uSpeedScale;
+uniform float uTime;
+uniform float uPointSpacing;   // World-space distance the sprite covers
+uniform float uPixelsPerUnit;  // Pixels per world unit at unit depth
+
+out vec3 FragColor;
+out float PointSize;
+
+void main()
+{
+    float s = min(1.0, aState.w * uSpeedScale);
+    FragColor = vec3(s, 0.2 + 0.8 * abs(sin(aState.w + uTime)), 1.0 - s);
+    gl_Position = projection * view * model * vec4(aState.xyz * uScale + uOffset, 1.0);
+    PointSize = uPointSpacing * uPixelsPerUnit / gl_Position.w;
+    gl_PointSize = clamp(PointSize, 1.0, 32.0);
+}
@@ -0,0 +1,21 @@
+#version 330 core
+
+// 2D variant of default.vert for planar modes: vertices are (x, y) in the z = 0
+// plane with a color, and one combined transform replaces model/view/projection.
+// Locations 2 and 3 are the other keyframe, as in default.vert.
+
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec2 aNextPos;
+layout (location = 3) in vec3 aNextColor;
+
+uniform mat4 uTransform;
+uniform float uKeyframeMix;
+
+out vec3 FragColor;
+
+void main()
+{
+    gl_Position = uTransform * vec4(mix(aPos, aNextPos, uKeyframeMix), 0.0, 1.0);
+    FragColor = mix(aColor, aNextColor, uKeyframeMix);
+}
@@ -0,0 +1,19 @@
+#version 330 core
+in vec3 FragColor;
+in float PointSize;
+out vec4 color;
+
+uniform bool uAdditive;
+
+void main()
+{
+    // Round sprite whose coverage falls off over one pixel at the rim. Sprites
+    // smaller than a pixel are drawn as one pixel; when blending additively they
+    // are weighted by their area so dense regions do not saturate. (Alpha blending
+    // is depth-tested, so overlapping faint sprites would not add up.)
+    float size = max(PointSize, 1.0);
+    float rim = (0.5 - length(gl_PointCoord - 0.5)) * size + 0.5;
+    float coverage = clamp(rim, 0.0, 1.0) * (uAdditive ? min(PointSize * PointSize, 1.0) : 1.0);
+    if (coverage <= 0.0) discard;
+    color = vec4(FragColor, coverage);
+}
@@ -0,0 +1,39 @@
+#version 330 core
+
+// CPU-generated point clouds drawn as sprites. Reads the full, planar and scalar
+// layouts through their VAOs: missing position components read as 0, and a
+// scalar vertex's single color float is mapped through the colormap. Locations 2
+// and 3 are the other keyframe, as in default.vert.
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec3 aNextPos;
+layout (location = 3) in vec3 aNextColor;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform float uKeyframeMix;
+uniform bool uScalarColor;
+uniform sampler1D uColormap;
+uniform float uPointSpacing;   // World-space distance the sprite covers
+uniform float uPixelsPerUnit;  // Pixels per world unit at unit depth
+
+out vec3 FragColor;
+out float PointSize;
+
+void main()
+{
+    vec3 color = mix(aColor, aNextColor, uKeyframeMix);
+    if (uScalarColor) {
+        float stops = float(textureSize(uColormap, 0));
+        FragColor = textureLod(uColormap, (clamp(color.x, 0.0, 1.0) * (stops - 1.0) + 0.5) / stops, 0.0).rgb;
+    } else {
+        FragColor = color;
+    }
+    gl_Position = projection * view * model * vec4(mix(aPos, aNextPos, uKeyframeMix), 1.0);
+
+    // Sprites span the sample spacing at their depth, so clouds stay closed up close
+    PointSize = uPointSpacing * uPixelsPerUnit / gl_Position.w;
+    gl_PointSize = clamp(PointSize, 1.0, 32.0);
+}
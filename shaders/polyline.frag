@@ -0,0 +1,23 @@
+#version 330 core
+in vec3 LineColor;
+in vec2 LinePosition;
+flat in float LineLength;
+flat in vec2 LineButts;
+out vec4 color;
+
+uniform float uWidth;
+uniform bool uMiter;
+
+void main()
+{
+    // Pixel distance from the center line, or from the segment for round joins and
+    // caps; coverage falls off over one pixel at the edge
+    vec2 outside = vec2(max(max(-LinePosition.x, LinePosition.x - LineLength), 0.0), LinePosition.y);
+    float distance = uMiter ? abs(LinePosition.y) : length(outside);
+    float coverage = clamp(0.5 * uWidth + 0.5 - distance, 0.0, 1.0);
+    // Butt ends of a strip fade the same way across the end
+    if (LineButts.x > 0.0) coverage *= clamp(LinePosition.x + 0.5, 0.0, 1.0);
+    if (LineButts.y > 0.0) coverage *= clamp(LineLength - LinePosition.x + 0.5, 0.0, 1.0);
+    if (coverage <= 0.0) discard;
+    color = vec4(LineColor, coverage);
+}
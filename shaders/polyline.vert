@@ -0,0 +1,123 @@
+#version 330 core
+
+// Screen-space polyline renderer. Each instance is one segment of the CPU vertex
+// buffer, expanded by a four-vertex triangle strip into a quad of exact pixel width. Vertices are
+// pulled from the buffer through a texture view, so one shader reads the full,
+// planar and scalar layouts and can look at the neighbouring segments for joins.
+
+uniform samplerBuffer uVertices;
+uniform samplerBuffer uNextVertices;  // The other keyframe, weighted by uKeyframeMix
+uniform float uKeyframeMix;
+uniform int uStride;              // Floats per vertex
+uniform int uPositionComponents;  // 3, or 2 for planar vertices
+uniform int uColorOffset;         // Index of the first color float within a vertex
+uniform bool uScalarColor;        // One colormap coordinate instead of r, g, b
+uniform sampler1D uColormap;
+uniform int uVertexCount;
+uniform int uStripLength;         // Vertices per strip when the buffer holds several strips, else 0
+uniform mat4 uTransform;
+uniform vec2 uViewport;           // Framebuffer size in pixels
+uniform float uWidth;             // Line width in pixels
+uniform bool uMiter;              // Miter joins and butt ends; otherwise round joins and caps
+
+out vec3 LineColor;
+out vec2 LinePosition;       // Pixels along the segment from its start, and from its center line
+flat out float LineLength;  // Segment length in pixels
+flat out vec2 LineButts;    // 1 where the start/end of the segment is a butt end of its strip
+
+const float nearW = 1e-3;
+
+float vertexFloat(int index)
+{
+    float value = texelFetch(uVertices, index).r;
+    return uKeyframeMix > 0.0 ? mix(value, texelFetch(uNextVertices, index).r, uKeyframeMix) : value;
+}
+
+vec4 clipPosition(int i)
+{
+    int base = i * uStride;
+    vec3 p = vec3(vertexFloat(base), vertexFloat(base + 1), 0.0);
+    if (uPositionComponents == 3) p.z = vertexFloat(base + 2);
+    return uTransform * vec4(p, 1.0);
+}
+
+vec3 vertexColor(int i)
+{
+    int base = i * uStride + uColorOffset;
+    if (uScalarColor) {
+        float stops = float(textureSize(uColormap, 0));
+        return textureLod(uColormap, (clamp(vertexFloat(base), 0.0, 1.0) * (stops - 1.0) + 0.5) / stops, 0.0).rgb;
+    }
+    return vec3(vertexFloat(base), vertexFloat(base + 1), vertexFloat(base + 2));
+}
+
+vec2 toScreen(vec4 clip)
+{
+    return (clip.xy / clip.w * 0.5 + 0.5) * uViewport;
+}
+
+bool sameStrip(int i, int j)
+{
+    return uStripLength == 0 || i / uStripLength == j / uStripLength;
+}
+
+void main()
+{
+    int a = gl_InstanceID, b = a + 1;
+    // Strip corner: which end of the segment, which side of it
+    int end = gl_VertexID >> 1;
+    float side = (gl_VertexID & 1) == 0 ? -1.0 : 1.0;
+
+    vec4 clipA = clipPosition(a), clipB = clipPosition(b);
+    // Segments bridging two strips or entirely behind the camera collapse to nothing
+    if (!sameStrip(a, b) || (clipA.w < nearW && clipB.w < nearW)) {
+        gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+    // Clip at the near plane so a point behind the camera does not fold the quad over
+    if (clipA.w < nearW) clipA = mix(clipA, clipB, (nearW - clipA.w) / (clipB.w - clipA.w));
+    if (clipB.w < nearW) clipB = mix(clipB, clipA, (nearW - clipB.w) / (clipA.w - clipB.w));
+
+    vec2 pa = toScreen(clipA), pb = toScreen(clipB);
+    float len = length(pb - pa);
+    vec2 dir = len > 1e-4 ? (pb - pa) / len : vec2(1.0, 0.0);
+    vec2 normal = vec2(-dir.y, dir.x);
+    float halfWidth = 0.5 * uWidth + 0.5;  // Out to where edge coverage reaches zero
+
+    vec2 offset = normal * side * halfWidth;
+    float along = end == 0 ? 0.0 : len;
+    LineButts = vec2(0.0);
+    if (uMiter) {
+        // Strip ends are butt ends, pushed out half a pixel for their anti-aliased edge
+        LineButts = vec2(a == 0 || !sameStrip(a - 1, a) ? 1.0 : 0.0, b + 1 >= uVertexCount || !sameStrip(b + 1, a) ? 1.0 : 0.0);
+        if (LineButts[end] > 0.0) {
+            float extend = end == 0 ? -0.5 : 0.5;
+            offset += dir * extend;
+            along += extend;
+        }
+
+        // Turn the end edge onto the bisector with the neighbouring segment, at most 4x long
+        int neighbour = end == 0 ? a - 1 : b + 1;
+        if (neighbour >= 0 && neighbour < uVertexCount && sameStrip(neighbour, a)) {
+            vec4 clipN = clipPosition(neighbour);
+            vec2 other = end == 0 ? pa - toScreen(clipN) : toScreen(clipN) - pb;
+            if (clipN.w > nearW && length(other) > 1e-4) {
+                vec2 tangent = normalize(normalize(other) + dir);
+                vec2 miter = vec2(-tangent.y, tangent.x);
+                offset = miter * side * halfWidth / max(dot(miter, normal), 0.25);
+            }
+        }
+    } else {
+        // Extend past both ends; the fragment shader trims the quad to a capsule
+        float extend = end == 0 ? -halfWidth : halfWidth;
+        offset += dir * extend;
+        along += extend;
+    }
+
+    vec4 clip = end == 0 ? clipA : clipB;
+    vec2 screen = (end == 0 ? pa : pb) + offset;
+    gl_Position = vec4(screen / uViewport * 2.0 - 1.0, clip.z / clip.w, 1.0);
+    LineColor = vertexColor(end == 0 ? a : b);
+    LinePosition = vec2(along, side * halfWidth);
+    LineLength = len;
+}
@@ -0,0 +1,12 @@
+#version 330 core
+in float Scalar;
+out vec4 color;
+
+uniform sampler1D uColormap;
+
+void main()
+{
+    // Sample at texel centers so 0 and 1 land exactly on the end stops
+    float stops = float(textureSize(uColormap, 0));
+    color = vec4(texture(uColormap, (clamp(Scalar, 0.0, 1.0) * (stops - 1.0) + 0.5) / stops).rgb, 1.0);
+}
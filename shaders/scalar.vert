@@ -0,0 +1,23 @@
+#version 330 core
+
+// CPU-generated vertices carrying one scalar in [0, 1] instead of a color; the
+// fragment shader maps it through the selected colormap. Locations 2 and 3 are the
+// other keyframe, as in default.vert.
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in float aScalar;
+layout (location = 2) in vec3 aNextPos;
+layout (location = 3) in float aNextScalar;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform float uKeyframeMix;
+
+out float Scalar;
+
+void main()
+{
+    gl_Position = projection * view * model * vec4(mix(aPos, aNextPos, uKeyframeMix), 1.0);
+    Scalar = mix(aScalar, aNextScalar, uKeyframeMix);
+}
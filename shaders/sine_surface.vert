@@ -0,0 +1,38 @@
+#version 330 core
+
+// Heightfield: displaces a static (x, z, aux) grid with a radial sine wave
+
+layout (location = 0) in vec3 aGrid;  // aGrid.z is the vertex's level in its chunk
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform float uTime;
+uniform float uPointSpacing;   // World-space distance the sprite covers
+uniform float uPixelsPerUnit;  // Pixels per world unit at unit depth
+uniform float uLodDistance;    // View distance at which the grid spacing first doubles
+uniform float uMaxLod;
+
+out vec3 FragColor;
+out float PointSize;
+
+void main()
+{
+    float x = aGrid.x;
+    float z = aGrid.y;
+    float dist = sqrt(x * x + z * z);
+    float y = 0.6 * sin(dist * 2.5 - uTime * 3.0) * exp(-dist * 0.4);
+
+    float heightIntensity = (y + 0.6) * 0.8 + 0.2;
+    FragColor = vec3(0.3 + 0.7 * heightIntensity,
+                     0.2 + 0.6 * sin(dist * 0.5 + uTime),
+                     0.8 + 0.2 * cos(dist * 0.3 + uTime * 1.2));
+    gl_Position = projection * view * model * vec4(x, y, z, 1.0);
+
+    // The level of detail rises with distance: finer levels shrink away while the
+    // coarser vertices grow to cover their wider spacing
+    float lod = clamp(log2(length((view * model * vec4(x, y, z, 1.0)).xyz) / uLodDistance), 0.0, uMaxLod);
+    float keep = clamp(aGrid.z + 1.0 - lod, 0.0, 1.0);
+    PointSize = uPointSpacing * exp2(lod) * keep * uPixelsPerUnit / gl_Position.w;
+    gl_PointSize = clamp(PointSize, 1.0, 32.0);
+}
@@ -0,0 +1,39 @@
+#version 330 core
+
+// Heightfield: gravitational well over a static (x, z, aux) grid
+
+layout (location = 0) in vec3 aGrid;  // aGrid.z is 1 for overlaid grid lines
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform float centralMass;
+uniform float maxDeformation;
+
+out vec3 FragColor;
+
+const float extent = 4.0;
+
+void main()
+{
+    float x = aGrid.x;
+    float z = aGrid.y;
+    float r = sqrt(x * x + z * z);
+    float y = 0.0;
+
+    if (r < extent) {
+        // Steep well near the mass blended into a parabolic bowl at the edges
+        float t = r / extent;
+        float depth = centralMass * maxDeformation;
+        float steepness = 4.0 * centralMass;
+        float well = 1.0 / (1.0 + steepness * t * t);
+        float parabolic = 1.0 - t * t;
+        float blend = exp(-3.0 * t);
+        y = -depth * (blend * well + (1.0 - blend) * parabolic);
+    }
+
+    // Grid lines sit slightly above the grey surface
+    y += 0.01 * aGrid.z;
+    FragColor = mix(vec3(0.6), vec3(1.0), aGrid.z);
+    gl_Position = projection * view * model * vec4(x, y, z, 1.0);
+}
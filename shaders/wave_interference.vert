@@ -0,0 +1,39 @@
+#version 330 core
+
+// Heightfield: displaces a static (x, z, aux) grid with two interfering plane waves
+
+layout (location = 0) in vec3 aGrid;  // aGrid.z is the vertex's level in its chunk
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform float uTime;
+uniform float k1;
+uniform float k2;
+uniform float omega1;
+uniform float omega2;
+uniform float uPointSpacing;   // World-space distance the sprite covers
+uniform float uPixelsPerUnit;  // Pixels per world unit at unit depth
+uniform float uLodDistance;    // View distance at which the grid spacing first doubles
+uniform float uMaxLod;
+
+out vec3 FragColor;
+out float PointSize;
+
+void main()
+{
+    float x = aGrid.x;
+    float z = aGrid.y;
+    float y = 0.5 * (sin(k1 * x - omega1 * uTime) + sin(k2 * z - omega2 * uTime));
+
+    float h = (y + 1.0) * 0.5;
+    FragColor = vec3(h, 1.0 - h, 0.5 + 0.5 * sin(uTime));
+    gl_Position = projection * view * model * vec4(x, y, z, 1.0);
+
+    // The level of detail rises with distance: finer levels shrink away while the
+    // coarser vertices grow to cover their wider spacing
+    float lod = clamp(log2(length((view * model * vec4(x, y, z, 1.0)).xyz) / uLodDistance), 0.0, uMaxLod);
+    float keep = clamp(aGrid.z + 1.0 - lod, 0.0, 1.0);
+    PointSize = uPointSpacing * exp2(lod) * keep * uPixelsPerUnit / gl_Position.w;
+    gl_PointSize = clamp(PointSize, 1.0, 32.0);
+}